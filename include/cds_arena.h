@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace cds {
+
+/// @brief A thread-safe monotonic memory arena. Memory is bump-allocated from
+/// large chunks and only released all at once, either by reset() (which keeps
+/// the chunks for reuse) or by release()/destruction.
+/// @warning Objects allocated from the arena are not destroyed by reset(). Any
+/// container using the arena must be destroyed (or be trivially destructible)
+/// before the arena is reset.
+class arena {
+ public:
+  /// @brief The default size of each chunk requested from operator new.
+  static constexpr std::size_t default_chunk_size = 64 * 1024;
+
+  /// @brief Constructs an empty arena. No memory is allocated until the
+  /// first allocation.
+  /// @param chunk_size The minimum size of each chunk.
+  explicit arena(const std::size_t chunk_size = default_chunk_size) noexcept
+      : chunk_size_(chunk_size) {}
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  /// @brief Releases all chunks.
+  ~arena() { release(); }
+
+  /// @brief Acquires the arena lock and bump-allocates bytes of storage.
+  /// @param bytes The number of bytes to allocate.
+  /// @param alignment The alignment of the storage; must be a power of two.
+  /// @return A pointer to the allocated storage.
+  void* allocate(const std::size_t bytes, const std::size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (void* p = bump(bytes, alignment)) {
+      return p;
+    }
+
+    // Move to the next retained chunk if it is large enough, otherwise
+    // splice a new chunk in after the current one.
+    if (current_ && current_->next &&
+        fits(current_->next, 0, bytes, alignment)) {
+      current_ = current_->next;
+    } else {
+      const std::size_t needed = sizeof(chunk) + bytes + alignment;
+      const std::size_t size = needed > chunk_size_ ? needed : chunk_size_;
+      chunk* c = static_cast<chunk*>(::operator new(size));
+      c->size = size - sizeof(chunk);
+      if (current_) {
+        c->next = current_->next;
+        current_->next = c;
+      } else {
+        c->next = head_;
+        head_ = c;
+      }
+      current_ = c;
+    }
+    offset_ = 0;
+
+    return bump(bytes, alignment);
+  }
+
+  /// @brief Rewinds the arena to its first chunk in O(1). All chunks are kept
+  /// and reused by subsequent allocations.
+  void reset() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ = head_;
+    offset_ = 0;
+  }
+
+  /// @brief Returns every chunk to the system.
+  void release() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (head_) {
+      chunk* next = head_->next;
+      ::operator delete(head_);
+      head_ = next;
+    }
+    current_ = nullptr;
+    offset_ = 0;
+  }
+
+ private:
+  struct alignas(std::max_align_t) chunk {
+    chunk* next;
+    std::size_t size;
+
+    char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+  };
+
+  const std::size_t chunk_size_;
+  chunk* head_ = nullptr;
+  chunk* current_ = nullptr;
+  std::size_t offset_ = 0;
+  std::mutex mutex_;
+
+  static std::size_t aligned_offset(chunk* c, const std::size_t offset,
+                                    const std::size_t alignment) noexcept {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(c->data());
+    const std::uintptr_t aligned =
+        (base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    return aligned - base;
+  }
+
+  static bool fits(chunk* c, const std::size_t offset, const std::size_t bytes,
+                   const std::size_t alignment) noexcept {
+    const std::size_t start = aligned_offset(c, offset, alignment);
+    return start <= c->size && bytes <= c->size - start;
+  }
+
+  void* bump(const std::size_t bytes, const std::size_t alignment) noexcept {
+    if (!current_ || !fits(current_, offset_, bytes, alignment)) {
+      return nullptr;
+    }
+
+    const std::size_t start = aligned_offset(current_, offset_, alignment);
+    offset_ = start + bytes;
+    return current_->data() + start;
+  }
+};
+
+/// @brief An allocator that draws memory from a cds::arena. Deallocation is a
+/// no-op; memory is reclaimed when the arena is reset or released.
+/// @tparam T The type of object to allocate.
+template <typename T>
+class arena_allocator {
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief arena_allocator size type.
+  using size_type = std::size_t;
+  /// @brief arena_allocator difference type.
+  using difference_type = std::ptrdiff_t;
+  /// @brief Containers copy the arena along with their contents.
+  using propagate_on_container_copy_assignment = std::true_type;
+  /// @brief Containers move the arena along with their contents.
+  using propagate_on_container_move_assignment = std::true_type;
+  /// @brief Containers swap arenas along with their contents.
+  using propagate_on_container_swap = std::true_type;
+
+  /// @brief Constructs an arena_allocator drawing from the given arena.
+  /// @param a The arena to allocate from. It must outlive the allocator.
+  arena_allocator(arena& a) noexcept : arena_(&a) {}
+
+  /// @brief Constructs an arena_allocator from an allocator of another type,
+  /// sharing its arena.
+  /// @tparam U The value type of other.
+  /// @param other The source allocator.
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) noexcept
+      : arena_(other.get_arena()) {}
+
+  /// @brief Allocates uninitialized storage for n objects of type T.
+  /// @param n The number of objects to allocate storage for.
+  /// @return A pointer to the allocated storage.
+  T* allocate(const size_type n) {
+    if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  /// @brief Does nothing; arena memory is released all at once.
+  void deallocate(T*, size_type) noexcept {}
+
+  /// @brief Returns the arena this allocator draws from.
+  /// @return A pointer to the arena.
+  arena* get_arena() const noexcept { return arena_; }
+
+ private:
+  arena* arena_;
+};
+
+/// @brief Two arena_allocators are equal if they draw from the same arena.
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs,
+                const arena_allocator<U>& rhs) noexcept {
+  return lhs.get_arena() == rhs.get_arena();
+}
+
+/// @brief Two arena_allocators are equal if they draw from the same arena.
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs,
+                const arena_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+}  // namespace cds
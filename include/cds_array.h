@@ -1,20 +1,32 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+#include "cds_serialize.h"
+#include "cds_simd.h"
+#include "cds_streaming.h"
+#include "cds_update_notifier.h"
 
 namespace cds {
 
 /// @brief A thread-safe static array inspired by std::array.
 /// @tparam T The type of object the array will hold.
 /// @tparam N The number of elements the array will hold.
-template <typename T, std::size_t N>
+/// @tparam Mutex The SharedMutex guarding the elements, e.g.
+/// std::shared_mutex or cds::bravo_shared_mutex for read-mostly use.
+template <typename T, std::size_t N, typename Mutex = std::shared_mutex>
 class cds_array {
   static_assert(N, "cds_array does not support empty arrays");
 
@@ -39,12 +51,19 @@ class cds_array {
   using size_type = std::size_t;
   /// @brief cds_array difference type.
   using difference_type = std::ptrdiff_t;
+  /// @brief Template parameter Mutex.
+  using mutex_type = Mutex;
 
   /// @brief A convenience struct which acquires a write lock for the target
   /// array and exposes an interface for batch writes. Unlike cds_array,
-  /// these functions do not acquire a lock at each write.
+  /// these functions do not acquire a lock at each write. When change
+  /// tracking is enabled, every element accessed through this interface is
+  /// recorded as changed, under a single version for the whole scope, and
+  /// taking iterators with begin() or end() records the whole array.
+  /// Waiters in wait_for_update() are notified once the scope ends.
   /// @warning This interface exposes non-const references, which can be used
-  /// outside the scope of the lock.
+  /// outside the scope of the lock. Writes through the array's own iterators
+  /// are not tracked; use the scoped_write's begin() and end() instead.
   struct scoped_write {
     /// @brief Construct a new scoped_write.
     /// @param arr The input cds_array to build the scoped_write object for.
@@ -54,6 +73,16 @@ class cds_array {
     scoped_write(scoped_write&&) = default;
     scoped_write& operator=(scoped_write&&) = default;
 
+    /// @brief Advances the version, releases the write lock, then notifies
+    /// update waiters.
+    ~scoped_write() {
+      if (lock_.owns_lock()) {
+        array_.notifier_.advance();
+        lock_.unlock();
+        array_.notifier_.wake();
+      }
+    }
+
     /// @brief Returns a reference to the value at the specified position.
     /// Functionally equivalent to operator[].
     /// @param pos The specified position.
@@ -63,9 +92,28 @@ class cds_array {
         throw std::out_of_range("element access out of range");
       }
 
+      mark_changed_(pos, pos + 1);
       return array_.buffer_[pos];
     }
 
+    /// @brief Returns an iterator pointing to the start of the array, valid
+    /// for the lifetime of this scope. With change tracking enabled, every
+    /// element is recorded as changed.
+    /// @return An iterator pointing to the start of the array.
+    iterator begin() {
+      mark_changed_(0, N);
+      return array_.begin();
+    }
+
+    /// @brief Returns an iterator pointing to the end of the array, valid for
+    /// the lifetime of this scope. With change tracking enabled, every
+    /// element is recorded as changed.
+    /// @return An iterator pointing to the end of the array.
+    iterator end() {
+      mark_changed_(0, N);
+      return array_.end();
+    }
+
     /// @brief Returns a reference to the value at the specified position.
     /// Functionally equivalent to at().
     /// @param pos The specified position.
@@ -82,7 +130,16 @@ class cds_array {
 
    private:
     cds_array& array_;
-    std::lock_guard<std::shared_mutex> lock_;
+    std::unique_lock<Mutex> lock_;
+
+    void mark_changed_(const size_type first, const size_type last) {
+      // Every writer advances the version under the write lock, so the
+      // version this scope will end with is the next one.
+      if (array_.changes_) {
+        array_.mark_changed_unlocked_(first, last,
+                                      array_.notifier_.version() + 1);
+      }
+    }
   };
 
   /// @brief A convenience struct which acquires a read lock for the target
@@ -125,7 +182,7 @@ class cds_array {
 
    private:
     cds_array& array_;
-    std::shared_lock<std::shared_mutex> lock_;
+    std::shared_lock<Mutex> lock_;
   };
 
   /// @brief Construct a cds_array from a list of values. Each value must be
@@ -135,20 +192,31 @@ class cds_array {
   template <typename... Ts>
   cds_array(Ts... ts) : buffer_{ts...} {}
 
-  /// @brief Copy constructor. Locks & copies the contents of other.
+  /// @brief Copy constructor. Locks & copies the contents of other. Arrays
+  /// larger than streaming_threshold() are copied with non-temporal stores.
   /// @param other The source cds_array to copy from.
   cds_array(const cds_array& other) {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
-    std::copy(other.cbegin(), other.cend(), begin());
+    std::lock_guard<Mutex> lock(other.mutex_);
+    detail::bulk_copy(other.buffer_, N, buffer_);
   }
 
   /// @brief Copy assignment operator. Locks both arrays and copies the
-  /// contents of other.
+  /// contents of other. Arrays larger than streaming_threshold() are copied
+  /// with non-temporal stores.
   /// @param other The source cds_array to copy from.
   /// @return A reference to the copied array (this).
   cds_array& operator=(const cds_array& other) {
-    std::scoped_lock lock(mutex_, other.mutex_);
-    std::copy(other.cbegin(), other.cend(), begin());
+    if (this == &other) {
+      return *this;
+    }
+
+    {
+      auto locks =
+          lock_in_order_<std::unique_lock<Mutex>>(mutex_, other.mutex_);
+      detail::bulk_copy(other.buffer_, N, buffer_);
+      mark_all_changed_unlocked_();
+    }
+    notifier_.wake();
     return *this;
   }
 
@@ -157,8 +225,8 @@ class cds_array {
   /// essentially a copy.
   /// @param other The source cds_array to copy from.
   cds_array(cds_array&& other) {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
-    std::copy(other.cbegin(), other.cend(), begin());
+    std::lock_guard<Mutex> lock(other.mutex_);
+    detail::bulk_copy(other.buffer_, N, buffer_);
   }
 
   /// @brief Move assignment operator.
@@ -166,8 +234,17 @@ class cds_array {
   /// essentially a copy.
   /// @param other The source cds_array to copy from.
   cds_array& operator=(cds_array&& other) {
-    std::scoped_lock lock(mutex_, other.mutex_);
-    std::copy(other.cbegin(), other.cend(), begin());
+    if (this == &other) {
+      return *this;
+    }
+
+    {
+      auto locks =
+          lock_in_order_<std::unique_lock<Mutex>>(mutex_, other.mutex_);
+      detail::bulk_copy(other.buffer_, N, buffer_);
+      mark_all_changed_unlocked_();
+    }
+    notifier_.wake();
     return *this;
   }
 
@@ -243,22 +320,233 @@ class cds_array {
       throw std::out_of_range("element access out of range");
     }
 
-    std::lock_guard<std::shared_mutex> write(mutex_);
-    buffer_[pos] = value;
+    {
+      std::lock_guard<Mutex> write(mutex_);
+      buffer_[pos] = value;
+      advance_unlocked_(pos, pos + 1);
+    }
+    notifier_.wake();
   }
 
   /// @brief Acquires a write lock and fills the array with the specified value.
+  /// Arrays larger than streaming_threshold() are filled with non-temporal
+  /// stores, so the fill does not evict other data from the cache.
   /// @param val The value to fill the array with.
   void fill(const_reference val) {
-    std::lock_guard<std::shared_mutex> lock(mutex_);
-    std::fill(begin(), end(), val);
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      detail::bulk_fill(buffer_, N, val);
+      mark_all_changed_unlocked_();
+    }
+    notifier_.wake();
   }
 
-  /// @brief Thread safe swap between two arrays.
+  /// @brief Thread safe swap between two arrays. Arithmetic elements are
+  /// swapped with the widest vector instructions the CPU supports.
   /// @param other The array to swap contents with.
   void swap(cds_array& other) {
-    std::scoped_lock lock(mutex_, other.mutex_);
-    std::swap_ranges(begin(), end(), other.begin());
+    if (this == &other) {
+      return;
+    }
+
+    {
+      auto locks =
+          lock_in_order_<std::unique_lock<Mutex>>(mutex_, other.mutex_);
+      detail::simd_swap(buffer_, other.buffer_, N);
+      mark_all_changed_unlocked_();
+      other.mark_all_changed_unlocked_();
+    }
+    notifier_.wake();
+    other.notifier_.wake();
+  }
+
+  /// @brief Returns the version, which advances once per completed
+  /// modification (set, fill, swap, assignment, deserialize or scoped_write
+  /// scope). Use it as the starting point for wait_for_update() and
+  /// changes_since().
+  /// @return The current version.
+  update_notifier::version_type version() const noexcept {
+    return notifier_.version();
+  }
+
+  /// @brief Blocks until the array is modified after version last_seen. The
+  /// caller spins briefly and then parks without holding any lock; writers
+  /// only make a wake-up call when a caller is parked.
+  /// @param last_seen The version the caller has already observed.
+  /// @return The new version.
+  update_notifier::version_type wait_for_update(
+      const update_notifier::version_type last_seen) const noexcept {
+    return notifier_.wait(last_seen);
+  }
+
+  /// @brief Blocks until the array is modified after version last_seen, or
+  /// timeout elapses.
+  /// @param last_seen The version the caller has already observed.
+  /// @param timeout The maximum time to wait.
+  /// @return The current version, which equals last_seen on timeout.
+  template <typename Rep, typename Period>
+  update_notifier::version_type wait_for_update(
+      const update_notifier::version_type last_seen,
+      const std::chrono::duration<Rep, Period>& timeout) const noexcept {
+    return notifier_.wait_for(last_seen, timeout);
+  }
+
+  /// @brief Acquires a write lock and starts recording which elements change:
+  /// the array keeps the version() of the last modification of each stripe
+  /// of elements. Copies of the array do not inherit change tracking.
+  /// @param stripe The number of adjacent elements sharing one version
+  /// stamp. Larger stripes use less memory but report unchanged neighbours
+  /// of a changed element as changed too.
+  void track_changes(const size_type stripe = 1) {
+    if (stripe == 0) {
+      throw std::invalid_argument("change tracking stripe must be non-zero");
+    }
+
+    auto changes = std::make_unique<change_log>();
+    changes->stripe = stripe;
+    changes->stripes.reset(new std::uint64_t[(N + stripe - 1) / stripe]());
+
+    std::lock_guard<Mutex> lock(mutex_);
+    changes_ = std::move(changes);
+  }
+
+  /// @brief Returns whether track_changes() was called on this array.
+  /// @return Whether change tracking is enabled.
+  bool tracking_changes() const {
+    std::shared_lock<Mutex> read(mutex_);
+    return changes_ != nullptr;
+  }
+
+  /// @brief Acquires a read lock and writes the position of every element
+  /// changed after version since to out, in ascending order. Passing the
+  /// returned version back in on the next call yields only newer changes.
+  /// @param since The last version the caller has seen; 0 reports every
+  /// element changed since tracking began.
+  /// @param out The output iterator receiving element positions.
+  /// @return The current version.
+  template <typename OutputIt>
+  std::uint64_t changes_since(const std::uint64_t since, OutputIt out) const {
+    std::shared_lock<Mutex> read(mutex_);
+    if (!changes_) {
+      throw std::logic_error("change tracking is not enabled");
+    }
+
+    const size_type stripe = changes_->stripe;
+    for (size_type s = 0; s < (N + stripe - 1) / stripe; ++s) {
+      if (changes_->stripes[s] > since) {
+        const size_type last = std::min(N, (s + 1) * stripe);
+        for (size_type pos = s * stripe; pos < last; ++pos) {
+          *out++ = pos;
+        }
+      }
+    }
+    return notifier_.version();
+  }
+
+  /// @brief Acquires a read lock once and passes a serial_header plus the raw
+  /// element buffer to writer in a single call, without copying either.
+  /// @tparam Writer Callable as writer(const io_slice*, std::size_t), e.g.
+  /// cds::fd_writer.
+  /// @param writer The destination of the serialized bytes.
+  template <typename Writer>
+  void serialize(Writer&& writer) const {
+    std::shared_lock<Mutex> read(mutex_);
+    detail::write_serialized(writer, buffer_, N);
+  }
+
+  /// @brief Acquires a read lock once and passes a serial_header, then the
+  /// raw element buffer in slices of at most chunk_bytes, to writer. Each
+  /// slice points into the array; nothing is copied.
+  /// @tparam Writer Callable as writer(const io_slice*, std::size_t).
+  /// @param writer The destination of the serialized bytes.
+  /// @param chunk_bytes The maximum slice size.
+  template <typename Writer>
+  void serialize_chunks(Writer&& writer,
+                        const std::size_t chunk_bytes = default_serial_chunk)
+      const {
+    std::shared_lock<Mutex> read(mutex_);
+    detail::write_serialized_chunks(writer, buffer_, N, chunk_bytes);
+  }
+
+  /// @brief Reads data produced by serialize() or serialize_chunks() into a
+  /// temporary buffer without holding any lock, then copies it into the
+  /// array under a single write lock. If reader throws, the array is left
+  /// unchanged.
+  /// @tparam Reader Callable as reader(void* dst, std::size_t bytes), filling
+  /// dst completely or throwing, e.g. cds::fd_reader.
+  /// @param reader The source of the serialized bytes.
+  template <typename Reader>
+  void deserialize(Reader&& reader) {
+    if (detail::read_serial_header<T>(reader) != N) {
+      throw std::length_error("serialized element count does not match N");
+    }
+
+    std::unique_ptr<unsigned char[]> staged(new unsigned char[sizeof(buffer_)]);
+    reader(static_cast<void*>(staged.get()), sizeof(buffer_));
+
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      std::memcpy(static_cast<void*>(buffer_), staged.get(), sizeof(buffer_));
+      mark_all_changed_unlocked_();
+    }
+    notifier_.wake();
+  }
+
+  /// @brief Acquires a read lock once and returns the position of the first
+  /// element equal to value. Arithmetic types are scanned with the widest
+  /// SIMD kernel supported by the CPU.
+  /// @param value The value to search for.
+  /// @return The position of the first match, or size() if there is none.
+  size_type find(const_reference value) const {
+    std::shared_lock<Mutex> read(mutex_);
+    return detail::simd_find(buffer_, N, value);
+  }
+
+  /// @brief Acquires a read lock once and counts the elements equal to value.
+  /// Arithmetic types are scanned with the widest SIMD kernel supported by
+  /// the CPU.
+  /// @param value The value to count.
+  /// @return The number of elements equal to value.
+  size_type count(const_reference value) const {
+    std::shared_lock<Mutex> read(mutex_);
+    return detail::simd_count(buffer_, N, value);
+  }
+
+  /// @brief Acquires a read lock once and returns the smallest element.
+  /// @return A copy of the smallest element.
+  value_type min() const {
+    std::shared_lock<Mutex> read(mutex_);
+    return *std::min_element(cbegin(), cend());
+  }
+
+  /// @brief Acquires a read lock once and returns the largest element.
+  /// @return A copy of the largest element.
+  value_type max() const {
+    std::shared_lock<Mutex> read(mutex_);
+    return *std::max_element(cbegin(), cend());
+  }
+
+  /// @brief Acquires read locks on both arrays (in address order) and
+  /// compares them element-wise.
+  /// @param other The array to compare with.
+  /// @return true if every element equals the matching element of other.
+  bool equal(const cds_array& other) const {
+    if (this == &other) {
+      return true;
+    }
+
+    auto locks = lock_in_order_<std::shared_lock<Mutex>>(mutex_, other.mutex_);
+    return detail::simd_equal(buffer_, other.buffer_, N);
+  }
+
+  /// @brief Compares two arrays element-wise. Equivalent to lhs.equal(rhs).
+  friend bool operator==(const cds_array& lhs, const cds_array& rhs) {
+    return lhs.equal(rhs);
+  }
+
+  /// @brief Compares two arrays element-wise. Equivalent to !lhs.equal(rhs).
+  friend bool operator!=(const cds_array& lhs, const cds_array& rhs) {
+    return !lhs.equal(rhs);
   }
 
   /// @brief Acquires a read lock and returns a const_reference to the value at
@@ -270,7 +558,7 @@ class cds_array {
       throw std::out_of_range("element access out of range");
     }
 
-    std::shared_lock<std::shared_mutex> read(mutex_);
+    std::shared_lock<Mutex> read(mutex_);
     return buffer_[pos];
   }
 
@@ -284,7 +572,7 @@ class cds_array {
   /// the front of the array.
   /// @return A reference to the value at the front of the array.
   const_reference front() const {
-    std::shared_lock<std::shared_mutex> read(mutex_);
+    std::shared_lock<Mutex> read(mutex_);
     return buffer_[0];
   }
 
@@ -292,7 +580,7 @@ class cds_array {
   /// the back of the array.
   /// @return A reference to the value at the back of the array.
   const_reference back() const {
-    std::shared_lock<std::shared_mutex> read(mutex_);
+    std::shared_lock<Mutex> read(mutex_);
     return buffer_[N - 1];
   }
 
@@ -312,7 +600,47 @@ class cds_array {
   constexpr size_type max_size() const noexcept { return N; }
 
  private:
+  // Change tracking state, allocated by track_changes() so that arrays that
+  // never track changes only pay for the pointer.
+  struct change_log {
+    size_type stripe = 1;
+    std::unique_ptr<std::uint64_t[]> stripes;
+  };
+
   T buffer_[N];
-  mutable std::shared_mutex mutex_;
+  mutable Mutex mutex_;
+  std::unique_ptr<change_log> changes_;
+  update_notifier notifier_;
+
+  /// @brief Locks two distinct mutexes in address order. Unlike
+  /// std::scoped_lock, this never backs off and retries, so FIFO queue locks
+  /// keep their place in line.
+  template <typename Lock>
+  static std::pair<Lock, Lock> lock_in_order_(Mutex& a, Mutex& b) {
+    Mutex& first = std::less<Mutex*>()(&a, &b) ? a : b;
+    Mutex& second = &first == &a ? b : a;
+    Lock first_lock(first);
+    Lock second_lock(second);
+    return {std::move(first_lock), std::move(second_lock)};
+  }
+
+  void mark_changed_unlocked_(const size_type first, const size_type last,
+                              const std::uint64_t version) {
+    const size_type stripe = changes_->stripe;
+    for (size_type s = first / stripe; s <= (last - 1) / stripe; ++s) {
+      changes_->stripes[s] = version;
+    }
+  }
+
+  // Advances the version for a modification of [first, last) and records it
+  // in the change log. Waiters are woken by wake() once the lock is dropped.
+  void advance_unlocked_(const size_type first, const size_type last) {
+    const std::uint64_t version = notifier_.advance();
+    if (changes_) {
+      mark_changed_unlocked_(first, last, version);
+    }
+  }
+
+  void mark_all_changed_unlocked_() { advance_unlocked_(0, N); }
 };
 }  // namespace cds
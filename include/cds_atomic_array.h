@@ -0,0 +1,322 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CDS_HAS_CMPXCHG16B 1
+#else
+#define CDS_HAS_CMPXCHG16B 0
+#endif
+
+namespace cds {
+
+namespace detail {
+
+/// @brief An atomic unsigned integer of at least Bytes bytes, for Bytes up
+/// to 8, backed by std::atomic.
+template <std::size_t Bytes>
+class atomic_word {
+ public:
+  using value_type = std::conditional_t<
+      Bytes <= 1, std::uint8_t,
+      std::conditional_t<Bytes <= 2, std::uint16_t,
+                         std::conditional_t<Bytes <= 4, std::uint32_t,
+                                            std::uint64_t>>>;
+
+  static constexpr bool is_always_lock_free =
+      std::atomic<value_type>::is_always_lock_free;
+
+  explicit atomic_word(const value_type value) noexcept : word_(value) {}
+
+  value_type load() const noexcept {
+    return word_.load(std::memory_order_acquire);
+  }
+
+  void store(const value_type value) noexcept {
+    word_.store(value, std::memory_order_release);
+  }
+
+  value_type exchange(const value_type value) noexcept {
+    return word_.exchange(value, std::memory_order_acq_rel);
+  }
+
+  bool compare_exchange(value_type& expected,
+                        const value_type desired) noexcept {
+    return word_.compare_exchange_strong(expected, desired,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<value_type> word_;
+};
+
+/// @brief A 16-byte atomic word. x86-64 uses lock cmpxchg16b for every
+/// operation, including loads; elsewhere a one-byte spinlock guards it.
+template <>
+class atomic_word<16> {
+ public:
+  struct alignas(16) value_type {
+    std::uint64_t lo;
+    std::uint64_t hi;
+  };
+
+  static constexpr bool is_always_lock_free = CDS_HAS_CMPXCHG16B;
+
+  explicit atomic_word(const value_type value) noexcept : word_(value) {}
+
+  value_type load() const noexcept {
+    // A failed compare-and-swap returns the current value; a successful one
+    // wrote back the value that was already there.
+    value_type expected{0, 0};
+    cas_(expected, expected);
+    return expected;
+  }
+
+  void store(const value_type value) noexcept { exchange(value); }
+
+  value_type exchange(const value_type value) noexcept {
+    value_type expected = load();
+    while (!cas_(expected, value)) {
+    }
+    return expected;
+  }
+
+  bool compare_exchange(value_type& expected,
+                        const value_type desired) noexcept {
+    return cas_(expected, desired);
+  }
+
+ private:
+  // Loads are compare-and-swaps too, so the word is mutable.
+  mutable value_type word_;
+#if !CDS_HAS_CMPXCHG16B
+  mutable std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+#endif
+
+  bool cas_(value_type& expected, const value_type desired) const noexcept {
+#if CDS_HAS_CMPXCHG16B
+    bool success;
+    __asm__ __volatile__("lock cmpxchg16b %1\n\tsete %0"
+                         : "=q"(success), "+m"(word_), "+a"(expected.lo),
+                           "+d"(expected.hi)
+                         : "b"(desired.lo), "c"(desired.hi)
+                         : "memory", "cc");
+    return success;
+#else
+    while (lock_.test_and_set(std::memory_order_acquire)) {
+    }
+    const bool success = word_.lo == expected.lo && word_.hi == expected.hi;
+    if (success) {
+      word_ = desired;
+    } else {
+      expected = word_;
+    }
+    lock_.clear(std::memory_order_release);
+    return success;
+#endif
+  }
+};
+
+template <std::size_t Bytes>
+using atomic_word_for =
+    atomic_word<(Bytes <= 8 ? Bytes : std::size_t{16})>;
+
+}  // namespace detail
+
+/// @brief A tiny fixed-size array stored in a single machine word (8 bytes,
+/// or 16 bytes using cmpxchg16b on x86-64), with no lock at all. Every
+/// operation reads or replaces the whole array atomically, so readers never
+/// see a torn array and set() on different positions never loses an update.
+/// Intended for huge numbers of small records, where cds_array's
+/// std::shared_mutex would dominate both size and latency.
+///
+/// Unlike cds_array, there is no scoped_write, no iterators, no change
+/// tracking and no wait_for_update(): element access returns copies, and
+/// multi-element updates go through compare_exchange().
+/// @tparam T The element type. It must be trivially copyable, and
+/// sizeof(T) * N must not exceed 16 bytes.
+/// @tparam N The number of elements the array will hold.
+template <typename T, std::size_t N>
+class cds_atomic_array {
+  static_assert(N, "cds_atomic_array does not support empty arrays");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "cds_atomic_array requires a trivially copyable type");
+  static_assert(sizeof(T) * N <= 16,
+                "cds_atomic_array holds at most 16 bytes; use cds_array");
+  static_assert(std::has_unique_object_representations_v<T> ||
+                    std::is_floating_point_v<T>,
+                "cds_atomic_array compares elements bytewise, so T must not "
+                "contain padding");
+
+  using word = detail::atomic_word_for<sizeof(T) * N>;
+  using word_type = typename word::value_type;
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief A snapshot of the whole array.
+  using array_type = std::array<T, N>;
+  /// @brief cds_atomic_array size type.
+  using size_type = std::size_t;
+
+  /// @brief Whether every operation is lock-free on this platform.
+  static constexpr bool is_always_lock_free = word::is_always_lock_free;
+
+  /// @brief Construct a cds_atomic_array from a list of values. Each value
+  /// must be convertible to type T. Missing values are value-initialized.
+  /// @tparam ...Ts Variadic template type.
+  /// @param ...ts Variadic argument used to initialize the array.
+  template <typename... Ts,
+            typename = std::enable_if_t<(std::is_convertible_v<Ts, T> && ...)>>
+  cds_atomic_array(Ts... ts) noexcept
+      : word_(pack_(array_type{static_cast<T>(ts)...})) {}
+
+  /// @brief Copy constructor. Atomically reads the contents of other.
+  /// @param other The source array to copy from.
+  cds_atomic_array(const cds_atomic_array& other) noexcept
+      : word_(other.word_.load()) {}
+
+  /// @brief Copy assignment operator. Atomically reads the contents of
+  /// other, then atomically replaces the contents of this array.
+  /// @param other The source array to copy from.
+  /// @return A reference to this array.
+  cds_atomic_array& operator=(const cds_atomic_array& other) noexcept {
+    word_.store(other.word_.load());
+    return *this;
+  }
+
+  /// @brief Atomically reads the whole array.
+  /// @return A snapshot of every element.
+  array_type load() const noexcept { return unpack_(word_.load()); }
+
+  /// @brief Atomically replaces the whole array.
+  /// @param values The new elements.
+  void store(const array_type& values) noexcept { word_.store(pack_(values)); }
+
+  /// @brief Atomically replaces the whole array and returns its old contents.
+  /// @param values The new elements.
+  /// @return A snapshot of the previous elements.
+  array_type exchange(const array_type& values) noexcept {
+    return unpack_(word_.exchange(pack_(values)));
+  }
+
+  /// @brief Atomically replaces the whole array with desired if it currently
+  /// equals expected. Elements are compared bytewise, like std::atomic.
+  /// @param expected The assumed contents. Updated to the actual contents on
+  /// failure.
+  /// @param desired The new contents.
+  /// @return true if the array was replaced.
+  bool compare_exchange(array_type& expected,
+                        const array_type& desired) noexcept {
+    word_type current = pack_(expected);
+    if (word_.compare_exchange(current, pack_(desired))) {
+      return true;
+    }
+    expected = unpack_(current);
+    return false;
+  }
+
+  /// @brief Returns a copy of the value at the specified position.
+  /// Functionally equivalent to operator[].
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type at(const size_type pos) const {
+    if (pos >= N) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    return load()[pos];
+  }
+
+  /// @brief Returns a copy of the value at the specified position.
+  /// Functionally equivalent to at().
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type operator[](const size_type pos) const { return at(pos); }
+
+  /// @brief Returns a copy of the value at the front of the array.
+  /// @return A copy of the value at the front of the array.
+  value_type front() const noexcept { return load()[0]; }
+
+  /// @brief Returns a copy of the value at the back of the array.
+  /// @return A copy of the value at the back of the array.
+  value_type back() const noexcept { return load()[N - 1]; }
+
+  /// @brief Sets the value at position pos to value, retrying until no
+  /// other write intervenes.
+  /// @param pos The position in the array to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, const value_type& value) {
+    if (pos >= N) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    array_type expected = load();
+    array_type desired;
+    do {
+      desired = expected;
+      desired[pos] = value;
+    } while (!compare_exchange(expected, desired));
+  }
+
+  /// @brief Atomically sets every element to value.
+  /// @param value The value to fill the array with.
+  void fill(const value_type& value) noexcept {
+    array_type values;
+    values.fill(value);
+    store(values);
+  }
+
+  /// @brief Swaps the contents of two arrays. Each array is replaced
+  /// atomically, but not both in one step: a concurrent reader may briefly
+  /// see both arrays holding the same contents, and a write to this array
+  /// that races with the swap is overwritten.
+  /// @param other The array to swap contents with.
+  void swap(cds_atomic_array& other) noexcept {
+    if (this != &other) {
+      store(other.exchange(load()));
+    }
+  }
+
+  /// @brief Compares two arrays element-wise, each read atomically.
+  friend bool operator==(const cds_atomic_array& lhs,
+                         const cds_atomic_array& rhs) noexcept {
+    return lhs.load() == rhs.load();
+  }
+
+  /// @brief Compares two arrays element-wise, each read atomically.
+  friend bool operator!=(const cds_atomic_array& lhs,
+                         const cds_atomic_array& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  /// @brief Returns the size of the array. This is equivalent to template
+  /// parameter N.
+  /// @return The size of the array.
+  constexpr size_type size() const noexcept { return N; }
+
+ private:
+  word word_;
+
+  // Unused bytes of the word stay zero so that bytewise comparison of two
+  // packed arrays only depends on their elements.
+  static word_type pack_(const array_type& values) noexcept {
+    word_type packed{};
+    std::memcpy(&packed, values.data(), sizeof(T) * N);
+    return packed;
+  }
+
+  static array_type unpack_(const word_type& packed) noexcept {
+    array_type values;
+    std::memcpy(values.data(), &packed, sizeof(T) * N);
+    return values;
+  }
+};
+}  // namespace cds
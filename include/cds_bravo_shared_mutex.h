@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cds_simd.h"
+
+namespace cds {
+
+namespace detail {
+
+/// @brief The visible readers table shared by every bravo_shared_mutex. A
+/// fast-path reader publishes the address of the lock it holds in the slot
+/// its thread and that lock hash to, so readers of one lock touch different
+/// cache lines instead of one shared counter.
+class bravo_reader_table {
+ public:
+  static constexpr std::size_t slot_count = 4096;
+
+  static bravo_reader_table& instance() noexcept {
+    static bravo_reader_table table;
+    return table;
+  }
+
+  std::atomic<const void*>& slot(const void* lock) noexcept {
+    // The address of a thread_local identifies the thread.
+    thread_local const char self = 0;
+    auto h = reinterpret_cast<std::uintptr_t>(&self) * 0x9E3779B97F4A7C15ull ^
+             reinterpret_cast<std::uintptr_t>(lock);
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 32;
+    return slots_[h % slot_count];
+  }
+
+  /// @brief Returns whether any reader has lock published in a slot.
+  bool contains(const void* lock) const noexcept {
+    for (const auto& s : slots_) {
+      if (s.load(std::memory_order_seq_cst) == lock) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Blocks until no reader has lock published in any slot.
+  void wait_until_empty(const void* lock) const noexcept {
+    for (const auto& s : slots_) {
+      for (int spin = 0; s.load(std::memory_order_seq_cst) == lock; ++spin) {
+        if (spin < 64) {
+#if CDS_SIMD_X86
+          _mm_pause();
+#endif
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+ private:
+  bravo_reader_table() = default;
+
+  std::atomic<const void*> slots_[slot_count] = {};
+};
+
+}  // namespace detail
+
+/// @brief A reader-biased reader-writer lock following BRAVO (Dice & Kogan,
+/// "BRAVO: Biased Locking for Reader-Writer Locks", USENIX ATC 2019). While
+/// the lock is read-biased, a reader does not touch the underlying lock at
+/// all: it claims a slot in a global visible readers table with a single
+/// compare-and-swap, so reads from many sockets no longer contend on a
+/// shared reader count. A writer revokes the bias, then waits for the
+/// table to drain of this lock. Revocation is expensive, so the bias stays
+/// off for a multiple of the time the last revocation took.
+///
+/// Meets the SharedMutex requirements and can replace std::shared_mutex as
+/// the Mutex parameter of cds_array and cds_vector.
+/// @tparam Underlying The lock used by writers and by readers that miss the
+/// fast path.
+template <typename Underlying = std::shared_mutex>
+class basic_bravo_shared_mutex {
+ public:
+  /// @brief How many times the last revocation's duration the bias stays
+  /// disabled for.
+  static constexpr int inhibit_multiplier = 9;
+
+  basic_bravo_shared_mutex() = default;
+  basic_bravo_shared_mutex(const basic_bravo_shared_mutex&) = delete;
+  basic_bravo_shared_mutex& operator=(const basic_bravo_shared_mutex&) = delete;
+
+  /// @brief Acquires exclusive ownership, revoking the read bias and waiting
+  /// for fast-path readers to leave.
+  void lock() {
+    underlying_.lock();
+    revoke_bias_();
+    failed_revocations_ = 0;
+  }
+
+  /// @brief Tries to acquire exclusive ownership without blocking. A
+  /// read-biased lock is revoked even if fast-path readers make this fail.
+  /// The bias then stays off for a window that doubles with every
+  /// consecutive failure, so that fast-path readers drain and a later
+  /// try_lock() succeeds even under a steady read load.
+  /// @return true if the lock was acquired.
+  bool try_lock() {
+    if (!underlying_.try_lock()) {
+      return false;
+    }
+    if (bias_.load(std::memory_order_relaxed) || draining_) {
+      bias_.store(false, std::memory_order_seq_cst);
+      const clock::time_point start = clock::now();
+      if (detail::bravo_reader_table::instance().contains(this)) {
+        const clock::time_point now = clock::now();
+        const int doublings =
+            failed_revocations_ < max_doublings ? failed_revocations_
+                                                : max_doublings;
+        ++failed_revocations_;
+        draining_ = true;
+        inhibit_until_ =
+            now + (now - start) * (inhibit_multiplier << doublings);
+        underlying_.unlock();
+        return false;
+      }
+      draining_ = false;
+    }
+    failed_revocations_ = 0;
+    return true;
+  }
+
+  /// @brief Releases exclusive ownership.
+  void unlock() { underlying_.unlock(); }
+
+  /// @brief Acquires shared ownership, through the visible readers table if
+  /// the lock is read-biased and the calling thread's slot is free.
+  void lock_shared() {
+    if (try_fast_lock_shared_()) {
+      return;
+    }
+
+    underlying_.lock_shared();
+    maybe_restore_bias_();
+  }
+
+  /// @brief Tries to acquire shared ownership.
+  /// @return true if the lock was acquired.
+  bool try_lock_shared() {
+    if (try_fast_lock_shared_()) {
+      return true;
+    }
+    if (!underlying_.try_lock_shared()) {
+      return false;
+    }
+    maybe_restore_bias_();
+    return true;
+  }
+
+  /// @brief Releases shared ownership.
+  void unlock_shared() {
+    auto& held = fast_holds_();
+    for (auto it = held.begin(); it != held.end(); ++it) {
+      if (it->first == this) {
+        it->second->store(nullptr, std::memory_order_release);
+        held.erase(it);
+        return;
+      }
+    }
+    underlying_.unlock_shared();
+  }
+
+  /// @brief Returns whether readers currently take the fast path.
+  /// @return true if the lock is read-biased.
+  bool read_biased() const noexcept {
+    return bias_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  // The most times a failed try_lock() doubles the inhibit window.
+  static constexpr int max_doublings = 10;
+
+  Underlying underlying_;
+  std::atomic<bool> bias_{false};
+  // Written only by writers holding underlying_ exclusively.
+  clock::time_point inhibit_until_{};
+  int failed_revocations_ = 0;
+  // Set when a try_lock() revoked the bias but fast-path readers were still
+  // present, so the next writer must wait for them even though the bias is
+  // already off.
+  bool draining_ = false;
+
+  // The fast-path holds of the calling thread, so that unlock_shared() can
+  // tell them from underlying holds. Another thread may have published the
+  // same lock in a colliding slot, so the slot contents alone do not say.
+  static std::vector<std::pair<const void*, std::atomic<const void*>*>>&
+  fast_holds_() {
+    thread_local std::vector<std::pair<const void*, std::atomic<const void*>*>>
+        held;
+    return held;
+  }
+
+  bool try_fast_lock_shared_() {
+    if (!bias_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    std::atomic<const void*>& slot =
+        detail::bravo_reader_table::instance().slot(this);
+    const void* expected = nullptr;
+    if (!slot.compare_exchange_strong(expected, this,
+                                      std::memory_order_seq_cst)) {
+      return false;
+    }
+    // Publishing before re-checking the bias pairs with revoke_bias_(),
+    // which clears the bias before scanning: one of them sees the other.
+    if (!bias_.load(std::memory_order_seq_cst)) {
+      slot.store(nullptr, std::memory_order_release);
+      return false;
+    }
+    fast_holds_().emplace_back(this, &slot);
+    return true;
+  }
+
+  void maybe_restore_bias_() {
+    if (!bias_.load(std::memory_order_relaxed) &&
+        clock::now() >= inhibit_until_) {
+      bias_.store(true, std::memory_order_seq_cst);
+    }
+  }
+
+  void revoke_bias_() {
+    if (!bias_.load(std::memory_order_relaxed) && !draining_) {
+      return;
+    }
+
+    bias_.store(false, std::memory_order_seq_cst);
+    const clock::time_point start = clock::now();
+    detail::bravo_reader_table::instance().wait_until_empty(this);
+    const clock::time_point now = clock::now();
+    inhibit_until_ = now + (now - start) * inhibit_multiplier;
+    draining_ = false;
+  }
+};
+
+/// @brief A BRAVO reader-biased lock over std::shared_mutex.
+using bravo_shared_mutex = basic_bravo_shared_mutex<>;
+}  // namespace cds
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "cds_numa.h"
+#include "cds_queue_lock.h"
+#include "cds_simd.h"
+
+namespace cds {
+
+namespace detail {
+
+/// @brief A ticket lock. It is thread-oblivious, meaning any thread may
+/// release it, and it can tell whether anyone is waiting, which are the two
+/// properties a cohort lock needs from its global and local locks.
+class ticket_lock {
+ public:
+  ticket_lock() = default;
+  ticket_lock(const ticket_lock&) = delete;
+  ticket_lock& operator=(const ticket_lock&) = delete;
+
+  void lock() noexcept {
+    const std::uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+    for (int spin = 0; serving_.load(std::memory_order_acquire) != ticket;
+         ++spin) {
+      if (spin < 128) {
+#if CDS_SIMD_X86
+        _mm_pause();
+#endif
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  bool try_lock() noexcept {
+    // Acquire pairs with the release in unlock(): the CAS on next_ alone
+    // does not order this thread after the previous critical section.
+    std::uint32_t ticket = serving_.load(std::memory_order_acquire);
+    return next_.compare_exchange_strong(ticket, ticket + 1,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    // Only the holder writes serving_, so a plain increment is enough.
+    serving_.store(serving_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+  }
+
+  /// @brief Returns whether a thread other than the holder has taken a
+  /// ticket. Only meaningful while the lock is held.
+  bool has_waiters() const noexcept {
+    return next_.load(std::memory_order_relaxed) -
+               serving_.load(std::memory_order_relaxed) >
+           1;
+  }
+
+ private:
+  std::atomic<std::uint32_t> next_{0};
+  std::atomic<std::uint32_t> serving_{0};
+};
+
+}  // namespace detail
+
+/// @brief A NUMA-aware cohort lock (Dice, Marathe & Shavit, "Lock Cohorting:
+/// A General Technique for Designing NUMA Locks", PPoPP 2012). Each NUMA node
+/// has its own local lock, and a thread first acquires the local lock of the
+/// node it runs on. The first thread of a cohort then takes the global lock;
+/// on release, if another thread of the same node is waiting, ownership of
+/// the global lock passes to it directly, up to a bounded number of times in
+/// a row before the global lock is released to the other nodes. The data the
+/// lock protects therefore stays in one socket's caches for whole batches of
+/// critical sections instead of moving between sockets on every handoff.
+///
+/// Meets the Lockable requirements. Use cohort_shared_mutex as the Mutex
+/// parameter of cds_array or cds_vector.
+class cohort_lock {
+ public:
+  /// @brief The default number of consecutive local handoffs.
+  static constexpr std::uint32_t default_max_local_passes = 64;
+
+  /// @brief Constructs a lock with one local lock per NUMA node.
+  /// @param max_local_passes How many times in a row ownership may pass to
+  /// a waiter on the same node before the other nodes get a turn.
+  explicit cohort_lock(
+      const std::uint32_t max_local_passes = default_max_local_passes)
+      : node_count_(numa_topology::instance().node_count()),
+        locals_(new local[node_count_]),
+        max_local_passes_(max_local_passes) {}
+
+  cohort_lock(const cohort_lock&) = delete;
+  cohort_lock& operator=(const cohort_lock&) = delete;
+
+  /// @brief Acquires the local lock of the calling thread's node, then the
+  /// global lock unless a previous owner on this node passed it along.
+  void lock() {
+    local& l = locals_[current_node_()];
+    l.lock.lock();
+    if (!l.global_held) {
+      global_.lock();
+      l.global_held = true;
+      l.passes = 0;
+    }
+    owner_ = &l;
+  }
+
+  /// @brief Acquires the lock only if both the local and the global lock
+  /// are free.
+  /// @return true if the lock was acquired.
+  bool try_lock() {
+    local& l = locals_[current_node_()];
+    if (!l.lock.try_lock()) {
+      return false;
+    }
+    // A free local lock is never handed the global lock: passes only go to
+    // a thread already waiting on it.
+    if (!global_.try_lock()) {
+      l.lock.unlock();
+      return false;
+    }
+    l.global_held = true;
+    l.passes = 0;
+    owner_ = &l;
+    return true;
+  }
+
+  /// @brief Passes ownership to a waiter on the same node if there is one
+  /// and the pass limit allows it; otherwise releases the global lock too.
+  void unlock() {
+    local& l = *owner_;
+    if (l.passes < max_local_passes_ && l.lock.has_waiters()) {
+      ++l.passes;
+    } else {
+      l.global_held = false;
+      global_.unlock();
+    }
+    l.lock.unlock();
+  }
+
+  /// @brief Returns the number of local locks, one per NUMA node.
+  /// @return The number of cohorts.
+  std::size_t node_count() const noexcept { return node_count_; }
+
+ private:
+  struct alignas(64) local {
+    detail::ticket_lock lock;
+    // Only read and written by the holder of lock.
+    bool global_held = false;
+    std::uint32_t passes = 0;
+  };
+
+  std::size_t node_count_;
+  std::unique_ptr<local[]> locals_;
+  std::uint32_t max_local_passes_;
+  alignas(64) detail::ticket_lock global_;
+  // Only read and written by the owner.
+  local* owner_ = nullptr;
+
+  std::size_t current_node_() const noexcept {
+    const std::size_t node = numa_topology::instance().cached_current_node();
+    return node < node_count_ ? node : 0;
+  }
+};
+
+/// @brief A SharedMutex whose writers are ordered by a cohort_lock, so that
+/// consecutive writers tend to come from the same socket. Use it as the
+/// Mutex parameter of cds_array or cds_vector.
+using cohort_shared_mutex = queued_shared_mutex<cohort_lock>;
+
+/// @brief A scoped owner of a cohort_lock.
+using cohort_guard = std::lock_guard<cohort_lock>;
+}  // namespace cds
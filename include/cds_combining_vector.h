@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "cds_simd.h"
+#include "cds_vector.h"
+
+namespace cds {
+
+/// @brief A cds_vector whose writes go through flat combining. A writer
+/// posts its operation (push_back, set or erase) in a publication slot and
+/// tries to become the combiner; the combiner applies every posted
+/// operation under a single write lock while the other writers wait on their
+/// own slot, so under contention the vector's lock and cache lines move
+/// between threads once per batch rather than once per operation.
+/// @tparam T The type of object the vector will hold.
+/// @tparam Allocator The allocator of the underlying cds_vector.
+template <typename T, typename Allocator = std::allocator<T>>
+class cds_combining_vector {
+ public:
+  /// @brief The underlying vector type.
+  using vector_type = cds_vector<T, Allocator>;
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief cds_combining_vector size type.
+  using size_type = std::size_t;
+
+  /// @brief The default number of publication slots.
+  static constexpr size_type default_slots = 64;
+
+  /// @brief Constructs an empty vector.
+  /// @param slots The number of publication slots. Each thread prefers its
+  /// own slot, so this should be at least the number of writer threads.
+  explicit cds_combining_vector(const size_type slots = default_slots)
+      : slot_count_(slots ? slots : 1),
+        slots_(std::make_unique<slot[]>(slot_count_)) {}
+
+  cds_combining_vector(const cds_combining_vector&) = delete;
+  cds_combining_vector& operator=(const cds_combining_vector&) = delete;
+
+  /// @brief Appends value to the end of the vector.
+  /// @param value The value to append.
+  void push_back(T value) { submit(op_kind::push_back, 0, std::move(value)); }
+
+  /// @brief Sets the value at position pos to value.
+  /// @param pos The position in the vector to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, T value) {
+    submit(op_kind::set, pos, std::move(value));
+  }
+
+  /// @brief Removes the element at position pos, shifting later elements
+  /// down by one.
+  /// @param pos The position of the element to remove.
+  void erase(const size_type pos) { submit(op_kind::erase, pos, std::nullopt); }
+
+  /// @brief Returns the underlying vector, for reads and scoped access.
+  /// Writes made directly on it bypass combining but remain thread-safe.
+  /// @return A reference to the underlying vector.
+  vector_type& vector() noexcept { return vector_; }
+
+  /// @brief Returns a new scoped_read of the underlying vector.
+  /// @return A new scoped_read instance for batch read operations.
+  typename vector_type::scoped_read new_scoped_read() {
+    return vector_.new_scoped_read();
+  }
+
+  /// @brief Returns the number of elements in the vector.
+  /// @return The number of elements in the vector.
+  size_type size() const noexcept { return vector_.size(); }
+
+ private:
+  enum class op_kind { push_back, set, erase };
+
+  enum slot_state : int { free_slot, filling, pending, done };
+
+  struct alignas(64) slot {
+    std::atomic<int> state{free_slot};
+    op_kind kind = op_kind::push_back;
+    size_type pos = 0;
+    std::optional<T> value;
+    std::exception_ptr error;
+  };
+
+  vector_type vector_;
+  size_type slot_count_;
+  std::unique_ptr<slot[]> slots_;
+  alignas(64) std::atomic<bool> combining_{false};
+
+  static size_type home_index() noexcept {
+    static std::atomic<size_type> next{0};
+    thread_local const size_type home =
+        next.fetch_add(1, std::memory_order_relaxed);
+    return home;
+  }
+
+  slot& acquire_slot() noexcept {
+    const size_type home = home_index();
+    for (size_type probe = 0;; ++probe) {
+      slot& s = slots_[(home + probe) % slot_count_];
+      int expected = free_slot;
+      if (s.state.load(std::memory_order_relaxed) == free_slot &&
+          s.state.compare_exchange_strong(expected, filling,
+                                          std::memory_order_acquire)) {
+        return s;
+      }
+      if ((probe + 1) % slot_count_ == 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void submit(const op_kind kind, const size_type pos,
+              std::optional<T> value) {
+    slot& s = acquire_slot();
+    s.kind = kind;
+    s.pos = pos;
+    s.value = std::move(value);
+    s.state.store(pending, std::memory_order_release);
+
+    for (int spin = 0; s.state.load(std::memory_order_acquire) != done;
+         ++spin) {
+      if (!combining_.load(std::memory_order_relaxed) &&
+          !combining_.exchange(true, std::memory_order_acquire)) {
+        struct release_combiner {
+          std::atomic<bool>& flag;
+          ~release_combiner() { flag.store(false, std::memory_order_release); }
+        } release{combining_};
+        try {
+          combine();
+        } catch (...) {
+          // Only taking the write lock can throw, before any slot is
+          // touched, so this operation was not applied. Free its slot.
+          s.value.reset();
+          s.state.store(free_slot, std::memory_order_release);
+          throw;
+        }
+      } else if (spin < 64) {
+#if CDS_SIMD_X86
+        _mm_pause();
+#endif
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    std::exception_ptr error = std::exchange(s.error, nullptr);
+    s.value.reset();
+    s.state.store(free_slot, std::memory_order_release);
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void combine() {
+    auto write = vector_.new_scoped_write();
+    for (size_type i = 0; i < slot_count_; ++i) {
+      slot& s = slots_[i];
+      if (s.state.load(std::memory_order_acquire) != pending) {
+        continue;
+      }
+
+      try {
+        switch (s.kind) {
+          case op_kind::push_back:
+            write.push_back(std::move(*s.value));
+            break;
+          case op_kind::set:
+            write.at(s.pos) = std::move(*s.value);
+            break;
+          case op_kind::erase:
+            write.erase(s.pos);
+            break;
+        }
+      } catch (...) {
+        s.error = std::current_exception();
+      }
+      s.state.store(done, std::memory_order_release);
+    }
+  }
+};
+}  // namespace cds
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "cds_array.h"
+
+namespace cds {
+
+/// @brief A cds_array of counters whose increments are combined per thread.
+/// add() writes only to the calling thread's private shadow of the array,
+/// with no lock and no atomic read-modify-write, and merge() later folds
+/// every shadow into the underlying cds_array under a single write lock.
+/// Reads of the underlying array are therefore stale by whatever has not
+/// been merged yet; at_merged() merges first when that matters.
+///
+/// For integers, each shadow holds running totals rather than pending
+/// deltas, so its owner never races with a merge: the owner only stores,
+/// and merge() remembers how much of each total it has already applied.
+/// Integer arithmetic wraps around like unsigned arithmetic. A floating
+/// point total would stop absorbing small deltas once it grew large, so
+/// floating point shadows hold pending deltas instead, which the owner adds
+/// to with an uncontended compare-and-swap and merge() takes with an
+/// exchange.
+/// @tparam T The arithmetic element type.
+/// @tparam N The number of elements the array will hold.
+template <typename T, std::size_t N>
+class cds_delta_array {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "cds_delta_array requires an arithmetic type");
+
+ public:
+  /// @brief The underlying array type.
+  using array_type = cds_array<T, N>;
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief cds_delta_array size type.
+  using size_type = std::size_t;
+
+  /// @brief Constructs an array of zeros.
+  /// @param flush_interval If non-zero, a thread merges its own shadow after
+  /// every flush_interval calls to add(), bounding how stale reads can be.
+  /// With 0, deltas are only applied by merge() and at_merged().
+  explicit cds_delta_array(const size_type flush_interval = 0)
+      : flush_interval_(flush_interval), id_(next_id_()) {}
+
+  cds_delta_array(const cds_delta_array&) = delete;
+  cds_delta_array& operator=(const cds_delta_array&) = delete;
+
+  /// @brief Adds delta to the element at position pos in the calling
+  /// thread's shadow. Takes no lock unless a periodic flush is due.
+  /// @param pos The position in the array to update.
+  /// @param delta The amount to add.
+  void add(const size_type pos, const value_type delta) {
+    if (pos >= N) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    shadow& s = local_shadow_();
+    // Setting dirty after the update means a merge that clears the flag
+    // either sees the update or leaves the flag set for next time.
+    if constexpr (std::is_integral_v<T>) {
+      // Only this thread writes its totals, so load + store cannot lose an
+      // update.
+      const accum total = s.totals[pos].load(std::memory_order_relaxed) +
+                          static_cast<accum>(delta);
+      s.totals[pos].store(total, std::memory_order_relaxed);
+    } else {
+      // merge() may take the pending delta at any time.
+      accum pending = s.totals[pos].load(std::memory_order_relaxed);
+      while (!s.totals[pos].compare_exchange_weak(
+          pending, pending + delta, std::memory_order_relaxed)) {
+      }
+    }
+    s.dirty.store(true, std::memory_order_release);
+
+    if (flush_interval_ && ++s.adds_since_flush == flush_interval_) {
+      s.adds_since_flush = 0;
+      std::lock_guard<std::mutex> lock(shadows_mutex_);
+      auto write = array_.new_scoped_write();
+      merge_unlocked_(s, write);
+    }
+  }
+
+  /// @brief Folds every thread's unmerged deltas into the underlying array
+  /// under one write lock. Every add() that happens before this call is
+  /// applied.
+  void merge() {
+    std::lock_guard<std::mutex> lock(shadows_mutex_);
+    auto write = array_.new_scoped_write();
+    for (const auto& s : shadows_) {
+      merge_unlocked_(*s, write);
+    }
+  }
+
+  /// @brief Acquires a read lock and returns a copy of the merged value at
+  /// the specified position, without applying pending deltas.
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos as of the last merge.
+  value_type at(const size_type pos) {
+    auto read = array_.new_scoped_read();
+    return read.at(pos);
+  }
+
+  /// @brief Merges all pending deltas, then returns a copy of the value at
+  /// the specified position.
+  /// @param pos The specified position.
+  /// @return A copy of the up-to-date value at position pos.
+  value_type at_merged(const size_type pos) {
+    merge();
+    return at(pos);
+  }
+
+  /// @brief Returns the underlying array, for scoped reads, change tracking
+  /// and wait_for_update(). It only reflects merged deltas.
+  /// @return A reference to the underlying array.
+  array_type& array() noexcept { return array_; }
+
+  /// @brief Returns the size of the array. This is equivalent to template
+  /// parameter N.
+  /// @return The size of the array.
+  constexpr size_type size() const noexcept { return N; }
+
+ private:
+  using accum =
+      typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>,
+                                  std::common_type<T>>::type;
+
+  struct alignas(64) shadow {
+    // Running totals for integers, pending deltas for floating point.
+    std::atomic<accum> totals[N] = {};
+    std::atomic<bool> dirty{false};
+    size_type adds_since_flush = 0;
+    // Guarded by shadows_mutex_. Only used for integers.
+    accum merged[N] = {};
+  };
+
+  // A thread's shadows, keyed by array id. The weak references expire when
+  // their array is destroyed, and expired entries are pruned whenever the
+  // map has doubled in size since the last pruning.
+  struct shadow_map {
+    std::unordered_map<std::uint64_t, std::weak_ptr<shadow>> shadows;
+    std::size_t prune_at = 16;
+  };
+
+  array_type array_;
+  size_type flush_interval_;
+  std::uint64_t id_;
+  std::mutex shadows_mutex_;
+  std::vector<std::shared_ptr<shadow>> shadows_;
+
+  static std::uint64_t next_id_() noexcept {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  shadow& local_shadow_() {
+    // Arrays are identified by a never-reused id rather than their address,
+    // so a destroyed array's entry can never be mistaken for a new one.
+    thread_local std::uint64_t cached_id = 0;
+    thread_local shadow* cached = nullptr;
+    if (cached_id == id_) {
+      return *cached;
+    }
+
+    thread_local shadow_map map;
+    shadow* s = nullptr;
+    auto it = map.shadows.find(id_);
+    if (it != map.shadows.end()) {
+      // This array is alive, so its shadow is too.
+      s = it->second.lock().get();
+    } else {
+      if (map.shadows.size() >= map.prune_at) {
+        prune_(map);
+      }
+      // Not make_shared, so that the shadow itself is freed with its array
+      // rather than with the last weak reference.
+      std::shared_ptr<shadow> created(new shadow());
+      map.shadows.emplace(id_, created);
+      s = created.get();
+      std::lock_guard<std::mutex> lock(shadows_mutex_);
+      shadows_.push_back(std::move(created));
+    }
+    cached_id = id_;
+    cached = s;
+    return *s;
+  }
+
+  static void prune_(shadow_map& map) {
+    for (auto it = map.shadows.begin(); it != map.shadows.end();) {
+      if (it->second.expired()) {
+        it = map.shadows.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    map.prune_at = std::max<std::size_t>(16, 2 * map.shadows.size());
+  }
+
+  void merge_unlocked_(shadow& s, typename array_type::scoped_write& write) {
+    if (!s.dirty.exchange(false, std::memory_order_acquire)) {
+      return;
+    }
+
+    for (size_type pos = 0; pos < N; ++pos) {
+      if constexpr (std::is_integral_v<T>) {
+        const accum total = s.totals[pos].load(std::memory_order_relaxed);
+        if (total != s.merged[pos]) {
+          const accum delta = total - s.merged[pos];
+          s.merged[pos] = total;
+          T& value = write[pos];
+          value = static_cast<T>(static_cast<accum>(value) + delta);
+        }
+      } else {
+        const T delta = s.totals[pos].exchange(0, std::memory_order_relaxed);
+        if (delta != 0) {
+          write[pos] += delta;
+        }
+      }
+    }
+  }
+};
+}  // namespace cds
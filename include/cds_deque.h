@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace cds {
+
+/// @brief A thread-safe double-ended queue built from a linked list of
+/// fixed-size chunks. The front and the back each have their own lock, so a
+/// producer at one end and a consumer at the other do not contend, and
+/// elements are never relocated by pushes or pops at either end.
+///
+/// An atomic element count arbitrates between the two ends: a push makes
+/// its element visible by incrementing it, and a pop first reserves an
+/// element by decrementing it, so the ends can never pop the same element.
+/// @tparam T The type of object the deque will hold.
+/// @tparam Allocator The allocator used to acquire/release chunks, and
+/// construct/destroy elements. Its pointer type must be T*.
+template <typename T, typename Allocator = std::allocator<T>>
+class cds_deque {
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::pointer, T*>,
+      "cds_deque requires an allocator with raw pointers");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Template parameter Allocator.
+  using allocator_type = Allocator;
+  /// @brief cds_deque size type.
+  using size_type = std::size_t;
+
+  /// @brief The number of elements per chunk.
+  static constexpr size_type chunk_elements =
+      std::max<size_type>(16, 4096 / sizeof(T));
+
+  /// @brief Constructs an empty deque.
+  /// @param alloc The allocator used for all memory allocations.
+  explicit cds_deque(const Allocator& alloc = Allocator()) : allocator_(alloc) {
+    chunk* c = allocate_chunk_(head_.spare);
+    head_.node = tail_.node = c;
+    head_.offset = tail_.offset = chunk_elements / 2;
+  }
+
+  cds_deque(const cds_deque&) = delete;
+  cds_deque& operator=(const cds_deque&) = delete;
+
+  /// @brief Destroys all elements and releases every chunk.
+  ~cds_deque() {
+    chunk* node = head_.node;
+    size_type offset = head_.offset;
+    while (node != tail_.node || offset != tail_.offset) {
+      std::allocator_traits<Allocator>::destroy(allocator_, node->slot(offset));
+      if (++offset == chunk_elements) {
+        node = node->next.load(std::memory_order_relaxed);
+        offset = 0;
+      }
+    }
+
+    for (chunk* c = head_.node; c;) {
+      chunk* next = c->next.load(std::memory_order_relaxed);
+      deallocate_chunk_(c);
+      c = next;
+    }
+    deallocate_chunk_(head_.spare);
+    deallocate_chunk_(tail_.spare);
+  }
+
+  /// @brief Acquires the back lock and appends value.
+  /// @param value The value to append.
+  void push_back(const T& value) { emplace_back(value); }
+
+  /// @brief Acquires the back lock and appends value by moving it.
+  /// @param value The value to append.
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /// @brief Acquires the back lock and constructs an element in place at the
+  /// back.
+  /// @param args The arguments forwarded to T's constructor.
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    std::lock_guard<std::mutex> lock(tail_.mutex);
+    chunk* node = tail_.node;
+    T* slot = node->slot(tail_.offset);
+    if (tail_.offset + 1 < chunk_elements) {
+      std::allocator_traits<Allocator>::construct(allocator_, slot,
+                                                  std::forward<Args>(args)...);
+      ++tail_.offset;
+    } else {
+      // Keep the end position inside a chunk by linking the next one first.
+      chunk* next = allocate_chunk_(tail_.spare);
+      try {
+        std::allocator_traits<Allocator>::construct(
+            allocator_, slot, std::forward<Args>(args)...);
+      } catch (...) {
+        release_chunk_(next, tail_.spare);
+        throw;
+      }
+      next->prev.store(node, std::memory_order_relaxed);
+      node->next.store(next, std::memory_order_relaxed);
+      tail_.node = next;
+      tail_.offset = 0;
+    }
+    size_.fetch_add(1, std::memory_order_release);
+  }
+
+  /// @brief Acquires the front lock and prepends value.
+  /// @param value The value to prepend.
+  void push_front(const T& value) { emplace_front(value); }
+
+  /// @brief Acquires the front lock and prepends value by moving it.
+  /// @param value The value to prepend.
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  /// @brief Acquires the front lock and constructs an element in place at
+  /// the front.
+  /// @param args The arguments forwarded to T's constructor.
+  template <typename... Args>
+  void emplace_front(Args&&... args) {
+    std::lock_guard<std::mutex> lock(head_.mutex);
+    chunk* node = head_.node;
+    if (head_.offset > 0) {
+      std::allocator_traits<Allocator>::construct(
+          allocator_, node->slot(head_.offset - 1),
+          std::forward<Args>(args)...);
+      --head_.offset;
+    } else {
+      chunk* prev = allocate_chunk_(head_.spare);
+      try {
+        std::allocator_traits<Allocator>::construct(
+            allocator_, prev->slot(chunk_elements - 1),
+            std::forward<Args>(args)...);
+      } catch (...) {
+        release_chunk_(prev, head_.spare);
+        throw;
+      }
+      prev->next.store(node, std::memory_order_relaxed);
+      node->prev.store(prev, std::memory_order_relaxed);
+      head_.node = prev;
+      head_.offset = chunk_elements - 1;
+    }
+    size_.fetch_add(1, std::memory_order_release);
+  }
+
+  /// @brief Acquires the front lock and removes the first element.
+  /// @return The removed element, or std::nullopt if the deque is empty.
+  std::optional<T> try_pop_front() {
+    std::lock_guard<std::mutex> lock(head_.mutex);
+    if (!reserve_()) {
+      return std::nullopt;
+    }
+
+    chunk* node = head_.node;
+    T* slot = node->slot(head_.offset);
+    std::optional<T> result = take_(slot);
+    if (head_.offset + 1 < chunk_elements) {
+      ++head_.offset;
+    } else {
+      // The back end has already moved past this chunk, so the next one is
+      // linked.
+      chunk* next = node->next.load(std::memory_order_relaxed);
+      next->prev.store(nullptr, std::memory_order_relaxed);
+      head_.node = next;
+      head_.offset = 0;
+      release_chunk_(node, head_.spare);
+    }
+    return result;
+  }
+
+  /// @brief Acquires the back lock and removes the last element.
+  /// @return The removed element, or std::nullopt if the deque is empty.
+  std::optional<T> try_pop_back() {
+    std::lock_guard<std::mutex> lock(tail_.mutex);
+    if (!reserve_()) {
+      return std::nullopt;
+    }
+
+    chunk* node = tail_.node;
+    const bool crosses = tail_.offset == 0;
+    chunk* owner = crosses ? node->prev.load(std::memory_order_relaxed) : node;
+    const size_type offset = (crosses ? chunk_elements : tail_.offset) - 1;
+    std::optional<T> result = take_(owner->slot(offset));
+    if (crosses) {
+      owner->next.store(nullptr, std::memory_order_relaxed);
+      tail_.node = owner;
+      release_chunk_(node, tail_.spare);
+    }
+    tail_.offset = offset;
+    return result;
+  }
+
+  /// @brief Returns the number of elements whose push has completed.
+  /// @return The number of elements in the deque.
+  size_type size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Checks if the deque is empty.
+  /// @return true if empty, false otherwise.
+  bool empty() const noexcept { return size() == 0; }
+
+ private:
+  struct chunk {
+    // Both ends read and write these links; the element count orders those
+    // accesses, so they only need to be race-free, not ordered themselves.
+    std::atomic<chunk*> prev{nullptr};
+    std::atomic<chunk*> next{nullptr};
+    alignas(T) unsigned char storage[chunk_elements * sizeof(T)];
+
+    T* slot(const size_type i) noexcept {
+      return std::launder(reinterpret_cast<T*>(storage) + i);
+    }
+  };
+
+  using chunk_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<chunk>;
+
+  struct alignas(64) end_state {
+    std::mutex mutex;
+    chunk* node = nullptr;
+    size_type offset = 0;
+    chunk* spare = nullptr;
+  };
+
+  Allocator allocator_;
+  end_state head_;
+  end_state tail_;
+  alignas(64) std::atomic<size_type> size_{0};
+
+  bool reserve_() noexcept {
+    size_type n = size_.load(std::memory_order_relaxed);
+    do {
+      if (n == 0) {
+        return false;
+      }
+    } while (!size_.compare_exchange_weak(n, n - 1, std::memory_order_acquire,
+                                          std::memory_order_relaxed));
+    return true;
+  }
+
+  std::optional<T> take_(T* slot) {
+    std::optional<T> result;
+    try {
+      result.emplace(std::move_if_noexcept(*slot));
+    } catch (...) {
+      size_.fetch_add(1, std::memory_order_release);
+      throw;
+    }
+    std::allocator_traits<Allocator>::destroy(allocator_, slot);
+    return result;
+  }
+
+  chunk* allocate_chunk_(chunk*& spare) {
+    if (spare) {
+      return std::exchange(spare, nullptr);
+    }
+
+    chunk_allocator alloc(allocator_);
+    chunk* c = std::allocator_traits<chunk_allocator>::allocate(alloc, 1);
+    return ::new (static_cast<void*>(c)) chunk();
+  }
+
+  void release_chunk_(chunk* c, chunk*& spare) noexcept {
+    c->prev.store(nullptr, std::memory_order_relaxed);
+    c->next.store(nullptr, std::memory_order_relaxed);
+    if (!spare) {
+      spare = c;
+    } else {
+      deallocate_chunk_(c);
+    }
+  }
+
+  void deallocate_chunk_(chunk* c) noexcept {
+    if (!c) {
+      return;
+    }
+
+    chunk_allocator alloc(allocator_);
+    c->~chunk();
+    std::allocator_traits<chunk_allocator>::deallocate(alloc, c, 1);
+  }
+};
+}  // namespace cds
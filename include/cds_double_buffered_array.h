@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace cds {
+
+/// @brief A fixed-size array with a front buffer for readers and a back
+/// buffer for a writer. Publishing the back buffer is a single atomic flip,
+/// regardless of N. Readers pin the front buffer with a per-buffer reference
+/// count, so a flip never waits for them; only a writer that starts writing
+/// into a buffer that readers still hold waits for them to finish.
+/// @tparam T The type of object the array will hold.
+/// @tparam N The number of elements the array will hold.
+template <typename T, std::size_t N>
+class double_buffered_array {
+  static_assert(N, "double_buffered_array does not support empty arrays");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Reference to T.
+  using reference = T&;
+  /// @brief Const reference to T.
+  using const_reference = const T&;
+  /// @brief Iterator type for T.
+  using iterator = value_type*;
+  /// @brief Const iterator type for T.
+  using const_iterator = const value_type*;
+  /// @brief double_buffered_array size type.
+  using size_type = std::size_t;
+
+  /// @brief Pins the current front buffer for batch reads. Writers may keep
+  /// publishing while a scoped_read is alive; it keeps seeing the buffer
+  /// that was current when it was created.
+  struct scoped_read {
+    /// @brief Construct a new scoped_read.
+    /// @param arr The input array to build the scoped_read object for.
+    explicit scoped_read(const double_buffered_array& arr)
+        : array_(&arr), index_(arr.pin()) {}
+    scoped_read(const scoped_read&) = delete;
+    scoped_read& operator=(const scoped_read&) = delete;
+
+    /// @brief Move constructor.
+    /// @param other The scoped_read to take the pin from.
+    scoped_read(scoped_read&& other) noexcept
+        : array_(std::exchange(other.array_, nullptr)), index_(other.index_) {}
+
+    /// @brief Releases the pin on the front buffer.
+    ~scoped_read() {
+      if (array_) {
+        array_->unpin(index_);
+      }
+    }
+
+    /// @brief Returns a const_reference to the value at the specified
+    /// position. Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference at(const size_type pos) const {
+      if (pos >= N) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return array_->buffers_[index_][pos];
+    }
+
+    /// @brief Returns a const_reference to the value at the specified
+    /// position. Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference operator[](const size_type pos) const { return at(pos); }
+
+    /// @brief Returns a const iterator pointing to the start of the pinned
+    /// buffer.
+    /// @return A const iterator pointing to the start of the buffer.
+    const_iterator begin() const { return array_->buffers_[index_]; }
+
+    /// @brief Returns a const iterator pointing to the end of the pinned
+    /// buffer.
+    /// @return A const iterator pointing to the end of the buffer.
+    const_iterator end() const { return array_->buffers_[index_] + N; }
+
+   private:
+    const double_buffered_array* array_;
+    unsigned index_;
+  };
+
+  /// @brief Gives exclusive access to the back buffer. Only one scoped_write
+  /// may exist at a time; others block until it is destroyed.
+  /// @warning This interface exposes non-const references, which can be
+  /// used outside the scope of the write.
+  struct scoped_write {
+    /// @brief Construct a new scoped_write.
+    /// @param arr The input array to build the scoped_write object for.
+    explicit scoped_write(double_buffered_array& arr)
+        : array_(arr), lock_(arr.writer_mutex_) {
+      array_.drain_back();
+    }
+    scoped_write(const scoped_write&) = delete;
+    scoped_write& operator=(const scoped_write&) = delete;
+
+    /// @brief Returns a reference to the value at the specified position in
+    /// the back buffer. Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference at(const size_type pos) {
+      if (pos >= N) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return back()[pos];
+    }
+
+    /// @brief Returns a reference to the value at the specified position in
+    /// the back buffer. Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+    /// @brief Returns an iterator pointing to the start of the back buffer.
+    /// @return An iterator pointing to the start of the back buffer.
+    iterator begin() { return back(); }
+
+    /// @brief Returns an iterator pointing to the end of the back buffer.
+    /// @return An iterator pointing to the end of the back buffer.
+    iterator end() { return back() + N; }
+
+    /// @brief Copies the front buffer into the back buffer, for writers that
+    /// update the previous frame rather than producing a whole new one.
+    void sync() {
+      const unsigned front =
+          array_.front_.load(std::memory_order_relaxed);
+      T* dst = back();
+      std::copy(array_.buffers_[front], array_.buffers_[front] + N, dst);
+    }
+
+    /// @brief Atomically makes the back buffer the front buffer, in O(1).
+    /// Subsequent writes through this scoped_write go to the new back
+    /// buffer (the old front), after any readers still pinning it are done.
+    void publish() {
+      const unsigned front = array_.front_.load(std::memory_order_relaxed);
+      array_.front_.store(front ^ 1U, std::memory_order_seq_cst);
+      drained_ = false;
+    }
+
+   private:
+    double_buffered_array& array_;
+    std::lock_guard<std::mutex> lock_;
+    bool drained_ = true;
+
+    T* back() {
+      if (!drained_) {
+        array_.drain_back();
+        drained_ = true;
+      }
+      return array_.buffers_[array_.front_.load(std::memory_order_relaxed) ^
+                             1U];
+    }
+  };
+
+  /// @brief Constructs a double_buffered_array with value-initialized
+  /// elements in both buffers.
+  double_buffered_array() : buffers_{} {}
+
+  double_buffered_array(const double_buffered_array&) = delete;
+  double_buffered_array& operator=(const double_buffered_array&) = delete;
+
+  /// @brief Returns a new scoped_read pinning the current front buffer.
+  /// @return A new scoped_read instance for batch read operations.
+  scoped_read new_scoped_read() const { return scoped_read(*this); }
+
+  /// @brief Returns a new scoped_write over the back buffer.
+  /// @return A new scoped_write instance for batch write operations.
+  scoped_write new_scoped_write() { return scoped_write(*this); }
+
+  /// @brief Returns a copy of the value at the specified position in the
+  /// front buffer. Functionally equivalent to operator[].
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type at(const size_type pos) const {
+    if (pos >= N) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    const unsigned index = pin();
+    value_type value = buffers_[index][pos];
+    unpin(index);
+    return value;
+  }
+
+  /// @brief Returns a copy of the value at the specified position in the
+  /// front buffer. Functionally equivalent to at().
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type operator[](const size_type pos) const { return at(pos); }
+
+  /// @brief Returns the size of the array. This is equivalent to template
+  /// parameter N.
+  /// @return The size of the array.
+  constexpr size_type size() const noexcept { return N; }
+
+ private:
+  struct alignas(64) reader_count {
+    std::atomic<std::size_t> value{0};
+  };
+
+  alignas(64) T buffers_[2][N];
+  mutable reader_count readers_[2];
+  alignas(64) std::atomic<unsigned> front_{0};
+  std::mutex writer_mutex_;
+
+  unsigned pin() const noexcept {
+    for (;;) {
+      const unsigned index = front_.load(std::memory_order_seq_cst);
+      readers_[index].value.fetch_add(1, std::memory_order_seq_cst);
+      // Recheck so that a writer that flipped and found the count at zero
+      // cannot start writing into the buffer we are about to read.
+      if (front_.load(std::memory_order_seq_cst) == index) {
+        return index;
+      }
+      readers_[index].value.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  void unpin(const unsigned index) const noexcept {
+    readers_[index].value.fetch_sub(1, std::memory_order_release);
+  }
+
+  void drain_back() const noexcept {
+    const unsigned back = front_.load(std::memory_order_seq_cst) ^ 1U;
+    while (readers_[back].value.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+  }
+};
+}  // namespace cds
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "cds_numa.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cds {
+
+/// @brief The page size requested by a huge_page_allocator.
+enum class page_size {
+  /// @brief Regular pages; no huge pages are requested.
+  standard,
+  /// @brief 2 MiB huge pages.
+  huge_2mb,
+  /// @brief 1 GiB huge pages.
+  huge_1gb,
+};
+
+/// @brief The NUMA placement requested by a huge_page_allocator.
+enum class numa_placement {
+  /// @brief Use the kernel's default (first-touch) placement.
+  local,
+  /// @brief Bind memory to a single node.
+  bind,
+  /// @brief Interleave pages across all nodes.
+  interleave,
+};
+
+/// @brief Options controlling how a huge_page_allocator maps memory.
+struct huge_page_options {
+  /// @brief The requested page size.
+  page_size pages = page_size::huge_2mb;
+  /// @brief The requested NUMA placement.
+  numa_placement placement = numa_placement::local;
+  /// @brief The node used when placement is numa_placement::bind.
+  std::size_t node = 0;
+
+  /// @brief Compares two option sets.
+  friend bool operator==(const huge_page_options& lhs,
+                         const huge_page_options& rhs) noexcept {
+    return lhs.pages == rhs.pages && lhs.placement == rhs.placement &&
+           lhs.node == rhs.node;
+  }
+};
+
+namespace detail {
+
+/// @brief Returns the size of the given page kind in bytes.
+/// @param pages The page kind.
+/// @return The page size in bytes.
+constexpr std::size_t page_bytes(const page_size pages) noexcept {
+  switch (pages) {
+    case page_size::huge_2mb:
+      return std::size_t(1) << 21;
+    case page_size::huge_1gb:
+      return std::size_t(1) << 30;
+    default:
+      return std::size_t(1) << 12;
+  }
+}
+
+#if defined(__linux__)
+/// @brief Maps bytes of anonymous memory, trying explicit huge pages first,
+/// then transparent huge pages, then regular pages.
+/// @param bytes The mapping size, a multiple of the page size.
+/// @param pages The requested page kind.
+/// @return The mapping, or nullptr if even a regular mapping failed.
+inline void* map_pages(const std::size_t bytes, const page_size pages) {
+  constexpr int prot = PROT_READ | PROT_WRITE;
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  void* p = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+  if (pages != page_size::standard) {
+    constexpr int huge_shift = 26;  // MAP_HUGE_SHIFT
+    const int size_flag = (pages == page_size::huge_1gb ? 30 : 21)
+                          << huge_shift;
+    p = mmap(nullptr, bytes, prot, flags | MAP_HUGETLB | size_flag, -1, 0);
+  }
+#endif
+
+  if (p == MAP_FAILED) {
+    p = mmap(nullptr, bytes, prot, flags, -1, 0);
+    if (p == MAP_FAILED) {
+      return nullptr;
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (pages != page_size::standard) {
+      // Best effort; fails harmlessly where THP is disabled.
+      madvise(p, bytes, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  return p;
+}
+
+/// @brief Applies a NUMA policy to a fresh mapping. Failures are ignored, so
+/// kernels without NUMA support keep the default placement.
+/// @param p The mapping.
+/// @param bytes The mapping size.
+/// @param options The requested placement.
+inline void place_pages(void* p, const std::size_t bytes,
+                        const huge_page_options& options) noexcept {
+#if defined(SYS_mbind)
+  if (options.placement == numa_placement::local) {
+    return;
+  }
+
+  constexpr std::size_t word_bits = sizeof(unsigned long) * CHAR_BIT;
+  constexpr std::size_t max_nodes = 1024;
+  unsigned long mask[max_nodes / word_bits] = {};
+  const numa_topology& topology = numa_topology::instance();
+  int mode = 0;
+  if (options.placement == numa_placement::bind) {
+    if (options.node >= max_nodes || options.node >= topology.node_count()) {
+      return;
+    }
+    mask[options.node / word_bits] |= 1UL << (options.node % word_bits);
+    mode = 2;  // MPOL_BIND
+  } else {
+    for (std::size_t node = 0;
+         node < topology.node_count() && node < max_nodes; ++node) {
+      mask[node / word_bits] |= 1UL << (node % word_bits);
+    }
+    mode = 3;  // MPOL_INTERLEAVE
+  }
+
+  // The kernel expects one more than the number of mask bits.
+  syscall(SYS_mbind, p, bytes, mode, mask, max_nodes + 1, 0);
+#else
+  (void)p;
+  (void)bytes;
+  (void)options;
+#endif
+}
+#endif
+
+}  // namespace detail
+
+/// @brief An allocator for large buffers that requests huge pages and NUMA
+/// placement from the kernel. Each allocation of at least one page gets its
+/// own mapping. Allocations of at least one huge page try explicit huge
+/// pages first, then transparent huge pages, then regular pages; smaller
+/// ones are mapped with regular pages. Allocations smaller than a regular
+/// page, and all allocations on systems without mmap, use operator new.
+/// @tparam T The type of object to allocate.
+template <typename T>
+class huge_page_allocator {
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief huge_page_allocator size type.
+  using size_type = std::size_t;
+  /// @brief huge_page_allocator difference type.
+  using difference_type = std::ptrdiff_t;
+  /// @brief Containers copy the options along with their contents.
+  using propagate_on_container_copy_assignment = std::true_type;
+  /// @brief Containers move the options along with their contents.
+  using propagate_on_container_move_assignment = std::true_type;
+  /// @brief Containers swap options along with their contents.
+  using propagate_on_container_swap = std::true_type;
+
+  /// @brief Constructs a huge_page_allocator with the given options.
+  /// @param options The page size and NUMA placement to request.
+  huge_page_allocator(const huge_page_options& options = {}) noexcept
+      : options_(options) {}
+
+  /// @brief Constructs a huge_page_allocator from an allocator of another
+  /// type, copying its options.
+  /// @tparam U The value type of other.
+  /// @param other The source allocator.
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U>& other) noexcept
+      : options_(other.options()) {}
+
+  /// @brief Allocates uninitialized storage for n objects of type T.
+  /// @param n The number of objects to allocate storage for.
+  /// @return A pointer to the allocated storage.
+  T* allocate(const size_type n) {
+    if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+
+    const std::size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+    if (mapped(bytes)) {
+      const std::size_t length = mapping_length(bytes);
+      void* p = detail::map_pages(length, mapped_pages(bytes));
+      if (!p) {
+        throw std::bad_alloc();
+      }
+      detail::place_pages(p, length, options_);
+      return static_cast<T*>(p);
+    }
+#endif
+
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return static_cast<T*>(
+          ::operator new(bytes, std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T*>(::operator new(bytes));
+    }
+  }
+
+  /// @brief Releases storage obtained from allocate().
+  /// @param p The pointer returned by allocate().
+  /// @param n The count passed to allocate().
+  void deallocate(T* p, const size_type n) noexcept {
+    const std::size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+    if (mapped(bytes)) {
+      munmap(p, mapping_length(bytes));
+      return;
+    }
+#endif
+
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  /// @brief Returns the options used by this allocator.
+  /// @return The allocator options.
+  const huge_page_options& options() const noexcept { return options_; }
+
+ private:
+  huge_page_options options_;
+
+  static bool mapped(const std::size_t bytes) noexcept {
+    return bytes >= detail::page_bytes(page_size::standard);
+  }
+
+  page_size mapped_pages(const std::size_t bytes) const noexcept {
+    // Huge pages only for allocations that fill at least one of them, so
+    // that a few KiB never pins a whole 2 MiB or 1 GiB page.
+    return bytes >= detail::page_bytes(options_.pages) ? options_.pages
+                                                       : page_size::standard;
+  }
+
+  std::size_t mapping_length(const std::size_t bytes) const noexcept {
+    // Round to the page size the mapping was requested with, so that huge
+    // page mappings and the munmap length always agree, whichever fallback
+    // was taken.
+    const std::size_t page = detail::page_bytes(mapped_pages(bytes));
+    return (bytes + page - 1) & ~(page - 1);
+  }
+};
+
+/// @brief Two huge_page_allocators are equal if they use the same options.
+template <typename T, typename U>
+bool operator==(const huge_page_allocator<T>& lhs,
+                const huge_page_allocator<U>& rhs) noexcept {
+  return lhs.options() == rhs.options();
+}
+
+/// @brief Two huge_page_allocators are equal if they use the same options.
+template <typename T, typename U>
+bool operator!=(const huge_page_allocator<T>& lhs,
+                const huge_page_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+}  // namespace cds
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "cds_mapped_vector requires POSIX mmap"
+#endif
+
+namespace cds {
+
+namespace detail {
+
+/// @brief The header at the start of every cds_mapped_vector file. Elements
+/// follow it at offset mapped_header_size.
+struct mapped_header {
+  /// @brief Identifies the file as a cds_mapped_vector.
+  std::uint64_t magic;
+  /// @brief The file format version.
+  std::uint32_t format_version;
+  /// @brief sizeof(T) of the writer, checked on open.
+  std::uint32_t element_size;
+  /// @brief The number of live elements.
+  std::uint64_t size;
+  /// @brief The number of elements the file has room for.
+  std::uint64_t capacity;
+};
+
+inline constexpr std::uint64_t mapped_magic = 0x524f544345564443ULL;
+inline constexpr std::uint32_t mapped_format_version = 1;
+inline constexpr std::size_t mapped_header_size = 64;
+
+static_assert(sizeof(mapped_header) <= mapped_header_size,
+              "mapped_header must fit in its reserved space");
+
+[[noreturn]] inline void throw_errno(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace detail
+
+/// @brief A thread-safe dynamic array whose buffer lives in a memory-mapped
+/// file, so a process can reopen it after a restart without parsing or
+/// copying. The file holds a versioned header followed by the raw elements;
+/// open_existing() validates the header and maps the data back as is.
+/// @tparam T The type of object the vector will hold. It must be trivially
+/// copyable, and the file is only portable between builds with the same
+/// layout of T.
+template <typename T>
+class cds_mapped_vector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "cds_mapped_vector requires a trivially copyable T");
+  static_assert(alignof(T) <= detail::mapped_header_size,
+                "cds_mapped_vector does not support over-aligned types");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Reference to T.
+  using reference = value_type&;
+  /// @brief Const reference to T.
+  using const_reference = const value_type&;
+  /// @brief Iterator type.
+  using iterator = value_type*;
+  /// @brief Const iterator type.
+  using const_iterator = const value_type*;
+  /// @brief cds_mapped_vector size type.
+  using size_type = std::size_t;
+  /// @brief cds_mapped_vector difference type.
+  using difference_type = std::ptrdiff_t;
+
+  /// @brief A convenience struct which acquires a write lock for the target
+  /// vector and exposes an interface for batch writes. Unlike
+  /// cds_mapped_vector, these functions do not acquire a lock at each write.
+  /// @warning This interface exposes non-const references, which can be used
+  /// outside the scope of the lock.
+  struct scoped_write {
+    /// @brief Construct a new scoped_write.
+    /// @param vec The input vector to build the scoped_write object for.
+    explicit scoped_write(cds_mapped_vector& vec)
+        : vector_(vec), lock_(vec.mutex_) {}
+    scoped_write(const scoped_write&) = delete;
+    scoped_write& operator=(const scoped_write&) = delete;
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference at(const size_type pos) {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.data_unlocked_()[pos];
+    }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+    /// @brief Appends value, growing the file if needed.
+    /// @param value The value to append.
+    void push_back(const_reference value) { vector_.push_back_unlocked_(value); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_mapped_vector& vector_;
+    std::lock_guard<std::shared_mutex> lock_;
+  };
+
+  /// @brief A convenience struct which acquires a read lock for the target
+  /// vector and exposes an interface for batch reads. Unlike
+  /// cds_mapped_vector, these functions do not acquire a lock at each read.
+  struct scoped_read {
+    /// @brief Construct a new scoped_read.
+    /// @param vec The input vector to build the scoped_read object for.
+    explicit scoped_read(cds_mapped_vector& vec)
+        : vector_(vec), lock_(vec.mutex_) {}
+    scoped_read(const scoped_read&) = delete;
+    scoped_read& operator=(const scoped_read&) = delete;
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference at(const size_type pos) const {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.data_unlocked_()[pos];
+    }
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference operator[](const size_type pos) const { return at(pos); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_mapped_vector& vector_;
+    std::shared_lock<std::shared_mutex> lock_;
+  };
+
+  /// @brief Creates (or truncates) the file at path and maps a new vector
+  /// holding count copies of value.
+  /// @param path The backing file.
+  /// @param count The initial number of elements.
+  /// @param value The value to set each element to.
+  /// @return The new vector.
+  static cds_mapped_vector create(const std::string& path,
+                                  const size_type count = 0,
+                                  const T& value = T()) {
+    const size_type capacity = std::max<size_type>(count, 1);
+    const size_type bytes = file_size(capacity);
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      detail::throw_errno("cds_mapped_vector: open failed");
+    }
+
+    cds_mapped_vector vec(fd, bytes);
+    detail::mapped_header& header = *vec.header_;
+    header.magic = detail::mapped_magic;
+    header.format_version = detail::mapped_format_version;
+    header.element_size = sizeof(T);
+    header.capacity = capacity;
+    std::fill(vec.data_unlocked_(), vec.data_unlocked_() + count, value);
+    header.size = count;
+    return vec;
+  }
+
+  /// @brief Maps an existing file created by create(). Elements are used in
+  /// place; nothing is parsed or copied.
+  /// @param path The backing file.
+  /// @return The mapped vector.
+  static cds_mapped_vector open_existing(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+      detail::throw_errno("cds_mapped_vector: open failed");
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      const int error = errno;
+      ::close(fd);
+      errno = error;
+      detail::throw_errno("cds_mapped_vector: fstat failed");
+    }
+
+    const size_type bytes = static_cast<size_type>(st.st_size);
+    if (bytes < detail::mapped_header_size) {
+      ::close(fd);
+      throw std::runtime_error("cds_mapped_vector: file is too small");
+    }
+
+    cds_mapped_vector vec(fd, bytes);
+    const detail::mapped_header& header = *vec.header_;
+    if (header.magic != detail::mapped_magic) {
+      throw std::runtime_error("cds_mapped_vector: not a mapped vector file");
+    }
+    if (header.format_version != detail::mapped_format_version) {
+      throw std::runtime_error("cds_mapped_vector: unsupported file version");
+    }
+    if (header.element_size != sizeof(T)) {
+      throw std::runtime_error("cds_mapped_vector: element size mismatch");
+    }
+    if (header.capacity == 0) {
+      throw std::runtime_error("cds_mapped_vector: capacity is zero");
+    }
+    // Divide rather than multiply so a huge capacity cannot overflow.
+    if (header.size > header.capacity ||
+        header.capacity > (bytes - detail::mapped_header_size) / sizeof(T)) {
+      throw std::runtime_error("cds_mapped_vector: file is truncated");
+    }
+    return vec;
+  }
+
+  /// @brief Move constructor. Locks other and takes over its mapping.
+  /// @param other The source vector, which is left empty and unmapped.
+  cds_mapped_vector(cds_mapped_vector&& other) noexcept {
+    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    fd_ = std::exchange(other.fd_, -1);
+    header_ = std::exchange(other.header_, nullptr);
+    mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+  }
+
+  cds_mapped_vector(const cds_mapped_vector&) = delete;
+  cds_mapped_vector& operator=(const cds_mapped_vector&) = delete;
+  cds_mapped_vector& operator=(cds_mapped_vector&&) = delete;
+
+  /// @brief Unmaps the file and closes it. Dirty pages are written back by
+  /// the kernel; call flush() first to be sure they reached the disk.
+  ~cds_mapped_vector() {
+    if (header_) {
+      ::munmap(header_, mapped_bytes_);
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  /// @brief Returns a new scoped_write from this vector for batch write
+  /// operations.
+  /// @return A new scoped_write instance for batch write operations.
+  scoped_write new_scoped_write() { return scoped_write(*this); }
+
+  /// @brief Returns a new scoped_read from this vector for batch read
+  /// operations.
+  /// @return A new scoped_read instance for batch read operations.
+  scoped_read new_scoped_read() { return scoped_read(*this); }
+
+  /// @brief Returns an iterator pointing to the start of the vector.
+  /// @warning begin() is not thread-safe by itself, and growth invalidates
+  /// it. Please acquire a scoped_write to ensure thread safe iteration.
+  /// @return An iterator pointing to the start of the vector.
+  iterator begin() { return data_unlocked_(); }
+
+  /// @brief Returns an iterator pointing to the end of the vector.
+  /// @warning end() is not thread-safe by itself, and growth invalidates
+  /// it. Please acquire a scoped_write to ensure thread safe iteration.
+  /// @return An iterator pointing to the end of the vector.
+  iterator end() { return data_unlocked_() + size_unlocked_(); }
+
+  /// @brief Acquires a read lock and returns a copy of the value at the
+  /// specified position. Functionally equivalent to operator[].
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type at(const size_type pos) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (pos >= size_unlocked_()) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    return data_unlocked_()[pos];
+  }
+
+  /// @brief Acquires a read lock and returns a copy of the value at the
+  /// specified position. Functionally equivalent to at().
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type operator[](const size_type pos) const { return at(pos); }
+
+  /// @brief Acquires a write lock and sets the value at position pos.
+  /// @param pos The position to update.
+  /// @param value The new value.
+  void set(const size_type pos, const_reference value) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (pos >= size_unlocked_()) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    data_unlocked_()[pos] = value;
+  }
+
+  /// @brief Acquires a write lock and appends value. When the file is full,
+  /// its capacity doubles and the file is remapped.
+  /// @param value The value to append.
+  void push_back(const_reference value) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    push_back_unlocked_(value);
+  }
+
+  /// @brief Acquires a write lock and grows the file to hold at least
+  /// capacity elements.
+  /// @param capacity The minimum capacity.
+  void reserve(const size_type capacity) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    reserve_unlocked_(capacity);
+  }
+
+  /// @brief Acquires a write lock and resizes the vector to count elements,
+  /// appending copies of value if it grows.
+  /// @param count The new size.
+  /// @param value The value of appended elements.
+  void resize(const size_type count, const_reference value = T()) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    const size_type size = size_unlocked_();
+    if (count > size) {
+      reserve_unlocked_(count);
+      std::fill(data_unlocked_() + size, data_unlocked_() + count, value);
+    }
+    header_->size = count;
+  }
+
+  /// @brief Acquires a read lock and synchronously writes the header and
+  /// all elements back to the file with msync.
+  void flush() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (::msync(header_, mapped_bytes_, MS_SYNC) != 0) {
+      detail::throw_errno("cds_mapped_vector: msync failed");
+    }
+  }
+
+  /// @brief Checks if the container is empty.
+  /// @return true if empty, false otherwise.
+  bool empty() const noexcept { return size() == 0; }
+
+  /// @brief Returns the number of elements in the container.
+  /// @return The number of elements in the container.
+  size_type size() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return size_unlocked_();
+  }
+
+  /// @brief Returns the number of elements the file has room for.
+  /// @return The capacity of the container.
+  size_type capacity() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<size_type>(header_->capacity);
+  }
+
+ private:
+  int fd_ = -1;
+  detail::mapped_header* header_ = nullptr;
+  size_type mapped_bytes_ = 0;
+  mutable std::shared_mutex mutex_;
+
+  /// @brief Takes ownership of fd, sizes the file to bytes and maps it.
+  cds_mapped_vector(const int fd, const size_type bytes) : fd_(fd) {
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0 ||
+        (static_cast<size_type>(st.st_size) < bytes &&
+         ::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)) {
+      const int error = errno;
+      ::close(fd_);
+      errno = error;
+      detail::throw_errno("cds_mapped_vector: sizing the file failed");
+    }
+
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd_);
+      errno = error;
+      detail::throw_errno("cds_mapped_vector: mmap failed");
+    }
+    header_ = static_cast<detail::mapped_header*>(p);
+    mapped_bytes_ = bytes;
+  }
+
+  // Throws std::length_error if the file for capacity elements would not fit
+  // in size_type or off_t, before anything touches the file.
+  static size_type file_size(const size_type capacity) {
+    constexpr size_type max_bytes =
+        std::min<std::uintmax_t>(std::numeric_limits<size_type>::max(),
+                                 std::numeric_limits<off_t>::max());
+    if (capacity > (max_bytes - detail::mapped_header_size) / sizeof(T)) {
+      throw std::length_error("cds_mapped_vector: capacity is too large");
+    }
+    return detail::mapped_header_size + capacity * sizeof(T);
+  }
+
+  T* data_unlocked_() const noexcept {
+    return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(header_) +
+                                detail::mapped_header_size);
+  }
+
+  size_type size_unlocked_() const noexcept {
+    return static_cast<size_type>(header_->size);
+  }
+
+  void push_back_unlocked_(const_reference value) {
+    const size_type size = size_unlocked_();
+    if (size == header_->capacity) {
+      reserve_unlocked_(std::max<size_type>(size * 2, 1));
+    }
+    data_unlocked_()[size] = value;
+    header_->size = size + 1;
+  }
+
+  void reserve_unlocked_(const size_type capacity) {
+    if (capacity <= header_->capacity) {
+      return;
+    }
+
+    const size_type bytes = file_size(capacity);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      detail::throw_errno("cds_mapped_vector: ftruncate failed");
+    }
+#if defined(__linux__)
+    void* p = ::mremap(header_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) {
+      detail::throw_errno("cds_mapped_vector: mremap failed");
+    }
+#else
+    void* p =
+        ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      detail::throw_errno("cds_mapped_vector: mmap failed");
+    }
+    ::munmap(header_, mapped_bytes_);
+#endif
+    header_ = static_cast<detail::mapped_header*>(p);
+    mapped_bytes_ = bytes;
+    header_->capacity = capacity;
+  }
+};
+}  // namespace cds
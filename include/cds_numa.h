@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cds {
+
+/// @brief A snapshot of the machine's NUMA topology. On systems without NUMA
+/// information, every CPU is reported as belonging to node 0.
+class numa_topology {
+ public:
+  /// @brief Returns the topology of the machine, read once on first use.
+  /// @return The process-wide numa_topology.
+  static const numa_topology& instance() {
+    static const numa_topology topology;
+    return topology;
+  }
+
+  /// @brief Returns the number of NUMA nodes. Node ids are in
+  /// [0, node_count()); some ids may have no CPUs on sparse systems.
+  /// @return The number of NUMA nodes, at least 1.
+  std::size_t node_count() const noexcept { return node_cpus_.size(); }
+
+  /// @brief Returns the CPUs belonging to the given node.
+  /// @param node The node id.
+  /// @return The CPU ids of node, or an empty list for unknown nodes.
+  const std::vector<unsigned>& cpus(const std::size_t node) const noexcept {
+    static const std::vector<unsigned> none;
+    return node < node_cpus_.size() ? node_cpus_[node] : none;
+  }
+
+  /// @brief Returns the node the given CPU belongs to.
+  /// @param cpu The CPU id.
+  /// @return The node id, or 0 if cpu is unknown.
+  std::size_t node_of_cpu(const unsigned cpu) const noexcept {
+    return cpu < cpu_node_.size() ? cpu_node_[cpu] : 0;
+  }
+
+  /// @brief Returns the node of the CPU the calling thread is running on. The
+  /// result is only a hint, since the thread may migrate at any time.
+  /// @return The current node id.
+  std::size_t current_node() const noexcept {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 &&
+        node < node_count()) {
+      return node;
+    }
+#endif
+    return 0;
+  }
+
+  /// @brief The number of calls after which cached_current_node() asks the
+  /// kernel again.
+  static constexpr unsigned node_refresh_interval = 256;
+
+  /// @brief Returns current_node(), cached per thread and refreshed every
+  /// node_refresh_interval calls, for hot paths that cannot afford a system
+  /// call each time. After a migration the result is stale for a while,
+  /// which only costs locality.
+  /// @return The current node id, as of the last refresh.
+  std::size_t cached_current_node() const noexcept {
+    thread_local std::size_t node = 0;
+    thread_local unsigned uses = 0;
+    if (uses++ % node_refresh_interval == 0) {
+      node = current_node();
+    }
+    return node;
+  }
+
+  /// @brief Parses a Linux cpulist string such as "0-3,8,10-11".
+  /// @param list The cpulist string.
+  /// @return The ids contained in list.
+  static std::vector<unsigned> parse_list(const std::string& list) {
+    std::vector<unsigned> ids;
+    std::size_t pos = 0;
+    while (pos < list.size()) {
+      std::size_t next = list.find(',', pos);
+      if (next == std::string::npos) {
+        next = list.size();
+      }
+
+      const std::string range = list.substr(pos, next - pos);
+      const std::size_t dash = range.find('-');
+      try {
+        const unsigned first = std::stoul(range.substr(0, dash));
+        const unsigned last = dash == std::string::npos
+                                  ? first
+                                  : std::stoul(range.substr(dash + 1));
+        for (unsigned id = first; id <= last; ++id) {
+          ids.push_back(id);
+        }
+      } catch (const std::exception&) {
+        // Skip malformed entries such as trailing whitespace.
+      }
+      pos = next + 1;
+    }
+    return ids;
+  }
+
+ private:
+  std::vector<std::vector<unsigned>> node_cpus_;
+  std::vector<std::size_t> cpu_node_;
+
+  numa_topology() {
+#if defined(__linux__)
+    const std::vector<unsigned> nodes =
+        parse_list(read_line("/sys/devices/system/node/online"));
+    for (const unsigned node : nodes) {
+      if (node_cpus_.size() <= node) {
+        node_cpus_.resize(node + 1);
+      }
+      node_cpus_[node] = parse_list(read_line(
+          "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+      for (const unsigned cpu : node_cpus_[node]) {
+        if (cpu_node_.size() <= cpu) {
+          cpu_node_.resize(cpu + 1, 0);
+        }
+        cpu_node_[cpu] = node;
+      }
+    }
+#endif
+
+    if (node_cpus_.empty()) {
+      const unsigned n = std::thread::hardware_concurrency();
+      node_cpus_.emplace_back();
+      for (unsigned cpu = 0; cpu < (n ? n : 1); ++cpu) {
+        node_cpus_[0].push_back(cpu);
+      }
+      cpu_node_.assign(node_cpus_[0].size(), 0);
+    }
+  }
+
+  static std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+  }
+};
+}  // namespace cds
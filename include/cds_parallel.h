@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cds {
+namespace parallel {
+
+/// @brief An execution policy that runs each parallel algorithm on a fresh
+/// set of threads. The calling thread always takes part in the work.
+/// @note Any type with a compatible parallel_for() member, such as
+/// cds::thread_pool, may be passed to the algorithms in place of a policy.
+class execution_policy {
+ public:
+  /// @brief The default minimum number of elements handed to one thread.
+  static constexpr std::size_t default_grain = 4096;
+
+  /// @brief Constructs an execution policy.
+  /// @param threads The maximum number of threads to use, including the
+  /// calling thread. 0 selects std::thread::hardware_concurrency().
+  /// @param grain The minimum number of elements handed to one thread. 0
+  /// selects default_grain.
+  explicit constexpr execution_policy(const std::size_t threads = 0,
+                                      const std::size_t grain = 0) noexcept
+      : threads_(threads), grain_(grain ? grain : default_grain) {}
+
+  /// @brief Returns the maximum number of threads this policy uses.
+  /// @return The thread count, at least 1.
+  std::size_t concurrency() const noexcept {
+    const std::size_t n =
+        threads_ ? threads_ : std::thread::hardware_concurrency();
+    return n ? n : 1;
+  }
+
+  /// @brief Returns the minimum number of elements handed to one thread.
+  /// @return The grain size.
+  constexpr std::size_t grain() const noexcept { return grain_; }
+
+  /// @brief Splits [first, last) into contiguous chunks of at least grain
+  /// indices and calls f(chunk_first, chunk_last) for each chunk, in
+  /// parallel. Returns once every chunk has completed. If any call throws,
+  /// the first exception is rethrown after all threads have joined.
+  /// @tparam F Callable with signature void(std::size_t, std::size_t).
+  /// @param first The first index of the range.
+  /// @param last One past the last index of the range.
+  /// @param grain The minimum chunk size; 0 selects this policy's grain.
+  /// @param f The function to call for each chunk.
+  template <typename F>
+  void parallel_for(const std::size_t first, const std::size_t last,
+                    std::size_t grain, F&& f) const {
+    if (first >= last) {
+      return;
+    }
+
+    grain = grain ? grain : grain_;
+    const std::size_t n = last - first;
+    const std::size_t max_chunks = (n + grain - 1) / grain;
+    const std::size_t chunks = std::min(concurrency(), max_chunks);
+    if (chunks <= 1) {
+      f(first, last);
+      return;
+    }
+
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [&](const std::size_t chunk) {
+      try {
+        f(first + n * chunk / chunks, first + n * (chunk + 1) / chunks);
+      } catch (...) {
+        errors[chunk] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    try {
+      for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        threads.emplace_back(run, chunk);
+      }
+    } catch (...) {
+      for (std::thread& t : threads) {
+        t.join();
+      }
+      throw;
+    }
+
+    run(0);
+    for (std::thread& t : threads) {
+      t.join();
+    }
+
+    for (const std::exception_ptr& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+ private:
+  std::size_t threads_;
+  std::size_t grain_;
+};
+
+/// @brief The default parallel execution policy, using every hardware thread.
+inline constexpr execution_policy par{};
+
+namespace detail {
+
+/// @brief Returns the number of elements in a locked container.
+template <typename Container>
+std::size_t locked_size(Container& c) {
+  return static_cast<std::size_t>(std::distance(c.begin(), c.end()));
+}
+
+}  // namespace detail
+
+/// @brief Acquires a write lock once and calls f on every element, with the
+/// buffer partitioned across the executor's threads.
+/// @param exec The execution policy or thread pool.
+/// @param c The cds_array or cds_vector to iterate.
+/// @param f The function to call with a reference to each element.
+template <typename Executor, typename Container, typename F>
+void for_each(Executor&& exec, Container& c, F f) {
+  auto lock = c.new_scoped_write();
+  auto first = lock.begin();
+  exec.parallel_for(0, detail::locked_size(c), 0,
+                    [first, &f](const std::size_t b, const std::size_t e) {
+                      std::for_each(first + b, first + e, f);
+                    });
+}
+
+/// @brief Acquires a write lock once and replaces every element x with
+/// op(x), in parallel.
+/// @param exec The execution policy or thread pool.
+/// @param c The cds_array or cds_vector to transform in place.
+/// @param op The unary operation to apply.
+template <typename Executor, typename Container, typename UnaryOp>
+void transform(Executor&& exec, Container& c, UnaryOp op) {
+  auto lock = c.new_scoped_write();
+  auto first = lock.begin();
+  exec.parallel_for(0, detail::locked_size(c), 0,
+                    [first, &op](const std::size_t b, const std::size_t e) {
+                      std::transform(first + b, first + e, first + b, op);
+                    });
+}
+
+/// @brief Acquires a read lock on src and a write lock on dst (in a
+/// deadlock-free order) and writes op(src[i]) to dst[i] for every element of
+/// src, in parallel.
+/// @param exec The execution policy or thread pool.
+/// @param src The container to read from.
+/// @param dst The container to write to. It must hold at least as many
+/// elements as src.
+/// @param op The unary operation to apply.
+template <typename Executor, typename Source, typename Dest, typename UnaryOp>
+void transform(Executor&& exec, Source& src, Dest& dst, UnaryOp op) {
+  if (static_cast<void*>(&src) == static_cast<void*>(&dst)) {
+    transform(std::forward<Executor>(exec), dst, op);
+    return;
+  }
+
+  std::optional<decltype(src.new_scoped_read())> read;
+  std::optional<decltype(dst.new_scoped_write())> write;
+  if (std::less<const void*>()(&src, &dst)) {
+    read.emplace(src);
+    write.emplace(dst);
+  } else {
+    write.emplace(dst);
+    read.emplace(src);
+  }
+
+  const std::size_t n = detail::locked_size(src);
+  if (detail::locked_size(dst) < n) {
+    throw std::length_error("transform destination is too small");
+  }
+
+  auto in = src.begin();
+  auto out = write->begin();
+  exec.parallel_for(0, n, 0,
+                    [in, out, &op](const std::size_t b, const std::size_t e) {
+                      std::transform(in + b, in + e, out + b, op);
+                    });
+}
+
+/// @brief Acquires a read lock once and reduces every element with op,
+/// in parallel. op must be associative; partial results are combined in
+/// order, so it need not be commutative.
+/// @param exec The execution policy or thread pool.
+/// @param c The container to reduce.
+/// @param init The initial value.
+/// @param op The binary reduction operation.
+/// @return The reduction of init and every element of c.
+template <typename Executor, typename Container, typename T,
+          typename BinaryOp = std::plus<>>
+T reduce(Executor&& exec, Container& c, T init, BinaryOp op = BinaryOp()) {
+  auto lock = c.new_scoped_read();
+  auto first = c.begin();
+  const std::size_t n = detail::locked_size(c);
+
+  std::mutex partials_mutex;
+  std::vector<std::pair<std::size_t, T>> partials;
+  exec.parallel_for(0, n, 0, [&](const std::size_t b, const std::size_t e) {
+    T partial = *(first + b);
+    for (std::size_t i = b + 1; i < e; ++i) {
+      partial = op(std::move(partial), *(first + i));
+    }
+
+    std::lock_guard<std::mutex> guard(partials_mutex);
+    partials.emplace_back(b, std::move(partial));
+  });
+
+  std::sort(partials.begin(), partials.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.first < rhs.first;
+            });
+  for (auto& partial : partials) {
+    init = op(std::move(init), std::move(partial.second));
+  }
+  return init;
+}
+
+/// @brief Acquires a write lock once and sorts the container: each thread
+/// sorts one slice, then slices are merged pairwise in parallel rounds.
+/// @param exec The execution policy or thread pool.
+/// @param c The container to sort.
+/// @param comp The comparison function.
+template <typename Executor, typename Container, typename Compare = std::less<>>
+void sort(Executor&& exec, Container& c, Compare comp = Compare()) {
+  auto lock = c.new_scoped_write();
+  auto first = lock.begin();
+  const std::size_t n = detail::locked_size(c);
+
+  // Sort each slice, recording the slice boundaries for the merge rounds.
+  std::vector<std::size_t> bounds{n};
+  std::mutex bounds_mutex;
+  exec.parallel_for(0, n, 0, [&](const std::size_t b, const std::size_t e) {
+    std::sort(first + b, first + e, comp);
+    std::lock_guard<std::mutex> guard(bounds_mutex);
+    bounds.push_back(b);
+  });
+  std::sort(bounds.begin(), bounds.end());
+  std::size_t slices = bounds.size() - 1;
+
+  while (slices > 1) {
+    const std::size_t merges = slices / 2;
+    exec.parallel_for(0, merges, 1,
+                      [&](const std::size_t b, const std::size_t e) {
+                        for (std::size_t m = b; m < e; ++m) {
+                          std::inplace_merge(first + bounds[2 * m],
+                                             first + bounds[2 * m + 1],
+                                             first + bounds[2 * m + 2], comp);
+                        }
+                      });
+
+    std::vector<std::size_t> next;
+    for (std::size_t i = 0; i < bounds.size(); i += 2) {
+      next.push_back(bounds[i]);
+    }
+    if (next.back() != n) {
+      next.push_back(n);
+    }
+    bounds.swap(next);
+    slices = bounds.size() - 1;
+  }
+}
+
+/// @brief Acquires a write lock once and assigns value to every element, in
+/// parallel.
+/// @param exec The execution policy or thread pool.
+/// @param c The container to fill.
+/// @param value The value to assign.
+template <typename Executor, typename Container, typename T>
+void fill(Executor&& exec, Container& c, const T& value) {
+  auto lock = c.new_scoped_write();
+  auto first = lock.begin();
+  exec.parallel_for(0, detail::locked_size(c), 0,
+                    [first, &value](const std::size_t b, const std::size_t e) {
+                      std::fill(first + b, first + e, value);
+                    });
+}
+
+/// @brief Acquires a read lock once and searches for the first element
+/// satisfying pred, in parallel. Slices past an already found match stop
+/// early.
+/// @param exec The execution policy or thread pool.
+/// @param c The container to search.
+/// @param pred The unary predicate.
+/// @return The index of the first element satisfying pred, or the size of
+/// the container if there is none.
+template <typename Executor, typename Container, typename UnaryPred>
+std::size_t find_if(Executor&& exec, Container& c, UnaryPred pred) {
+  auto lock = c.new_scoped_read();
+  auto first = c.begin();
+  const std::size_t n = detail::locked_size(c);
+
+  std::atomic<std::size_t> found(n);
+  exec.parallel_for(0, n, 0, [&](const std::size_t b, const std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      if (i >= found.load(std::memory_order_relaxed)) {
+        return;
+      }
+      if (pred(*(first + i))) {
+        std::size_t current = found.load(std::memory_order_relaxed);
+        while (i < current && !found.compare_exchange_weak(current, i)) {
+        }
+        return;
+      }
+    }
+  });
+  return found.load();
+}
+
+}  // namespace parallel
+}  // namespace cds
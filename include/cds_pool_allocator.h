@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace cds {
+namespace detail {
+
+/// @brief The smallest block size served by the pool, in bytes.
+inline constexpr std::size_t pool_min_block = 16;
+/// @brief The largest block size served by the pool, in bytes. Larger
+/// requests go straight to operator new.
+inline constexpr std::size_t pool_max_block = 4096;
+/// @brief The number of power-of-two size classes between pool_min_block and
+/// pool_max_block.
+inline constexpr std::size_t pool_class_count = 9;
+/// @brief The number of blocks moved between a thread cache and the depot in
+/// one transfer.
+inline constexpr std::size_t pool_batch_size = 32;
+/// @brief The minimum number of bytes carved from operator new at once.
+inline constexpr std::size_t pool_chunk_size = 64 * 1024;
+
+/// @brief Returns the size class index serving a request of the given size.
+/// @param bytes The requested size in bytes (at most pool_max_block).
+/// @return The size class index.
+constexpr std::size_t pool_size_class(const std::size_t bytes) noexcept {
+  std::size_t size = pool_min_block;
+  std::size_t cls = 0;
+  while (size < bytes) {
+    size <<= 1;
+    ++cls;
+  }
+  return cls;
+}
+
+/// @brief Returns the block size of the given size class.
+/// @param cls The size class index.
+/// @return The block size in bytes.
+constexpr std::size_t pool_block_size(const std::size_t cls) noexcept {
+  return pool_min_block << cls;
+}
+
+/// @brief A free block, linked into a free list.
+struct pool_block {
+  pool_block* next;
+};
+
+/// @brief A singly linked list of free blocks of one size class.
+struct pool_batch {
+  pool_block* head = nullptr;
+  std::size_t count = 0;
+};
+
+/// @brief The process-wide store of free blocks. Thread caches exchange whole
+/// batches with the depot, so its locks are taken once per pool_batch_size
+/// allocations rather than once per allocation.
+class pool_depot {
+ public:
+  pool_depot(const pool_depot&) = delete;
+  pool_depot& operator=(const pool_depot&) = delete;
+
+  /// @brief Returns the depot. The depot is never destroyed, so thread caches
+  /// may return blocks to it at any point during shutdown.
+  /// @return The process-wide depot.
+  static pool_depot& instance() {
+    static pool_depot* const depot = new pool_depot();
+    return *depot;
+  }
+
+  /// @brief Takes a batch of free blocks of the given size class, carving a
+  /// new chunk if the depot has none.
+  /// @param cls The size class index.
+  /// @return A non-empty batch of free blocks.
+  pool_batch acquire(const std::size_t cls) {
+    size_class& sc = classes_[cls];
+    {
+      std::lock_guard<std::mutex> lock(sc.mutex);
+      if (!sc.batches.empty()) {
+        const pool_batch batch = sc.batches.back();
+        sc.batches.pop_back();
+        return batch;
+      }
+    }
+
+    return carve(cls);
+  }
+
+  /// @brief Returns a batch of free blocks to the depot.
+  /// @param cls The size class index.
+  /// @param batch The batch to return.
+  void release(const std::size_t cls, const pool_batch batch) {
+    if (!batch.head) {
+      return;
+    }
+
+    size_class& sc = classes_[cls];
+    std::lock_guard<std::mutex> lock(sc.mutex);
+    sc.batches.push_back(batch);
+  }
+
+ private:
+  struct size_class {
+    std::mutex mutex;
+    std::vector<pool_batch> batches;
+  };
+
+  size_class classes_[pool_class_count];
+  std::mutex chunk_mutex_;
+  std::vector<void*> chunks_;
+
+  pool_depot() = default;
+
+  pool_batch carve(const std::size_t cls) {
+    const std::size_t block = pool_block_size(cls);
+    const std::size_t bytes = block * pool_batch_size > pool_chunk_size
+                                  ? block * pool_batch_size
+                                  : pool_chunk_size;
+    char* chunk = static_cast<char*>(::operator new(bytes));
+    {
+      std::lock_guard<std::mutex> lock(chunk_mutex_);
+      chunks_.push_back(chunk);
+    }
+
+    // Thread the chunk into batches; the first one goes to the caller and
+    // the rest are stocked in the depot.
+    std::vector<pool_batch> batches;
+    pool_batch batch;
+    for (std::size_t offset = bytes; offset >= block; offset -= block) {
+      pool_block* b = reinterpret_cast<pool_block*>(chunk + offset - block);
+      b->next = batch.head;
+      batch.head = b;
+      if (++batch.count == pool_batch_size) {
+        batches.push_back(batch);
+        batch = pool_batch();
+      }
+    }
+    if (batch.head) {
+      batches.push_back(batch);
+    }
+
+    const pool_batch result = batches.back();
+    batches.pop_back();
+    if (!batches.empty()) {
+      size_class& sc = classes_[cls];
+      std::lock_guard<std::mutex> lock(sc.mutex);
+      sc.batches.insert(sc.batches.end(), batches.begin(), batches.end());
+    }
+    return result;
+  }
+};
+
+/// @brief Set once the calling thread's pool_cache has been destroyed. It is
+/// trivially destructible, so thread_local objects destroyed after the cache
+/// can still read it.
+inline thread_local bool pool_cache_destroyed = false;
+
+/// @brief A per-thread cache of free blocks. Allocation and deallocation only
+/// touch the cache of the calling thread; blocks freed by a thread other than
+/// the one that allocated them simply join the freeing thread's cache.
+class pool_cache {
+ public:
+  pool_cache() = default;
+  pool_cache(const pool_cache&) = delete;
+  pool_cache& operator=(const pool_cache&) = delete;
+
+  /// @brief Returns all cached blocks to the depot. Blocks that cannot be
+  /// returned stay owned by their chunk and are simply not reused.
+  ~pool_cache() {
+    pool_cache_destroyed = true;
+    for (std::size_t cls = 0; cls < pool_class_count; ++cls) {
+      try {
+        pool_depot::instance().release(cls, lists_[cls]);
+      } catch (...) {
+      }
+    }
+  }
+
+  /// @brief Pops a block of the given size class, refilling from the depot if
+  /// the cache is empty.
+  /// @param cls The size class index.
+  /// @return A pointer to an uninitialized block.
+  void* allocate(const std::size_t cls) {
+    pool_batch& list = lists_[cls];
+    if (!list.head) {
+      list = pool_depot::instance().acquire(cls);
+    }
+
+    pool_block* b = list.head;
+    list.head = b->next;
+    --list.count;
+    return b;
+  }
+
+  /// @brief Pushes a block of the given size class, spilling one batch to the
+  /// depot once the cache holds two batches.
+  /// @param cls The size class index.
+  /// @param p The block to free.
+  void deallocate(const std::size_t cls, void* p) noexcept {
+    pool_batch& list = lists_[cls];
+    pool_block* b = static_cast<pool_block*>(p);
+    b->next = list.head;
+    list.head = b;
+    if (++list.count < 2 * pool_batch_size) {
+      return;
+    }
+
+    pool_batch spill;
+    spill.head = list.head;
+    pool_block* last = list.head;
+    for (std::size_t i = 1; i < pool_batch_size; ++i) {
+      last = last->next;
+    }
+    list.head = last->next;
+    last->next = nullptr;
+    spill.count = pool_batch_size;
+    list.count -= pool_batch_size;
+
+    try {
+      pool_depot::instance().release(cls, spill);
+    } catch (...) {
+      // The depot could not grow; keep the blocks cached instead.
+      last->next = list.head;
+      list.head = spill.head;
+      list.count += pool_batch_size;
+    }
+  }
+
+ private:
+  pool_batch lists_[pool_class_count];
+};
+
+/// @brief Returns the cache of the calling thread.
+/// @return The calling thread's pool_cache.
+inline pool_cache& local_pool_cache() {
+  thread_local pool_cache cache;
+  return cache;
+}
+
+/// @brief Allocates a block from the calling thread's cache, or straight from
+/// the depot once the cache has been destroyed.
+/// @param cls The size class index.
+/// @return A pointer to an uninitialized block.
+inline void* pool_allocate(const std::size_t cls) {
+  if (!pool_cache_destroyed) {
+    return local_pool_cache().allocate(cls);
+  }
+
+  pool_batch batch = pool_depot::instance().acquire(cls);
+  pool_block* b = batch.head;
+  batch.head = b->next;
+  --batch.count;
+  try {
+    pool_depot::instance().release(cls, batch);
+  } catch (...) {
+    // The rest of the batch stays owned by its chunk.
+  }
+  return b;
+}
+
+/// @brief Frees a block to the calling thread's cache, or straight to the
+/// depot once the cache has been destroyed.
+/// @param cls The size class index.
+/// @param p The block to free.
+inline void pool_deallocate(const std::size_t cls, void* p) noexcept {
+  if (!pool_cache_destroyed) {
+    local_pool_cache().deallocate(cls, p);
+    return;
+  }
+
+  pool_batch batch;
+  batch.head = static_cast<pool_block*>(p);
+  batch.head->next = nullptr;
+  batch.count = 1;
+  try {
+    pool_depot::instance().release(cls, batch);
+  } catch (...) {
+    // The block stays owned by its chunk and is simply not reused.
+  }
+}
+
+}  // namespace detail
+
+/// @brief A fixed-size block allocator backed by thread-local caches and a
+/// global depot. Requests are rounded up to power-of-two size classes between
+/// 16 and 4096 bytes; larger or over-aligned requests fall through to
+/// operator new. Memory is reused by the pool and never returned to the
+/// system.
+/// @tparam T The type of object to allocate.
+template <typename T>
+class pool_allocator {
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief pool_allocator size type.
+  using size_type = std::size_t;
+  /// @brief pool_allocator difference type.
+  using difference_type = std::ptrdiff_t;
+  /// @brief All pool_allocators share the same pool.
+  using is_always_equal = std::true_type;
+  /// @brief Containers may move memory between pool_allocators freely.
+  using propagate_on_container_move_assignment = std::true_type;
+
+  /// @brief Constructs a pool_allocator.
+  pool_allocator() noexcept = default;
+
+  /// @brief Constructs a pool_allocator from an allocator of another type.
+  /// @tparam U The value type of other.
+  template <typename U>
+  pool_allocator(const pool_allocator<U>&) noexcept {}
+
+  /// @brief Allocates uninitialized storage for n objects of type T.
+  /// @param n The number of objects to allocate storage for.
+  /// @return A pointer to the allocated storage.
+  T* allocate(const size_type n) {
+    if (n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+
+    const std::size_t bytes = n * sizeof(T);
+    if (!pooled(bytes)) {
+      if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T*>(
+            ::operator new(bytes, std::align_val_t(alignof(T))));
+      } else {
+        return static_cast<T*>(::operator new(bytes));
+      }
+    }
+
+    return static_cast<T*>(
+        detail::pool_allocate(detail::pool_size_class(bytes)));
+  }
+
+  /// @brief Releases storage obtained from allocate(). The storage may have
+  /// been allocated by any thread.
+  /// @param p The pointer returned by allocate().
+  /// @param n The count passed to allocate().
+  void deallocate(T* p, const size_type n) noexcept {
+    const std::size_t bytes = n * sizeof(T);
+    if (!pooled(bytes)) {
+      if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+      } else {
+        ::operator delete(p);
+      }
+      return;
+    }
+
+    detail::pool_deallocate(detail::pool_size_class(bytes), p);
+  }
+
+  /// @brief Returns the largest supported allocation size.
+  /// @return The maximum number of objects that can be allocated at once.
+  constexpr size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+
+ private:
+  static constexpr bool pooled(const std::size_t bytes) noexcept {
+    return alignof(T) <= detail::pool_min_block &&
+           bytes <= detail::pool_max_block;
+  }
+};
+
+/// @brief All pool_allocators compare equal.
+template <typename T, typename U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept {
+  return true;
+}
+
+/// @brief All pool_allocators compare equal.
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept {
+  return false;
+}
+}  // namespace cds
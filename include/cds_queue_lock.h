@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "cds_simd.h"
+
+namespace cds {
+
+namespace detail {
+
+/// @brief A queue lock waiter record, alone on its cache line so that each
+/// waiter spins on memory no other waiter writes.
+struct alignas(64) queue_node {
+  std::atomic<queue_node*> next{nullptr};
+  std::atomic<bool> locked{false};
+};
+
+/// @brief A per-thread cache of free queue_nodes, so that lock() needs no
+/// allocation in the steady state. Nodes left at thread exit are freed.
+class queue_node_pool {
+ public:
+  static queue_node* acquire() {
+    std::vector<queue_node*>& nodes = local_().nodes_;
+    if (nodes.empty()) {
+      return new queue_node;
+    }
+    queue_node* node = nodes.back();
+    nodes.pop_back();
+    return node;
+  }
+
+  static void release(queue_node* node) { local_().nodes_.push_back(node); }
+
+  ~queue_node_pool() {
+    for (queue_node* node : nodes_) {
+      delete node;
+    }
+  }
+
+ private:
+  std::vector<queue_node*> nodes_;
+
+  static queue_node_pool& local_() {
+    thread_local queue_node_pool pool;
+    return pool;
+  }
+};
+
+/// @brief Spins until flag reads value, pausing at first and then yielding
+/// so that oversubscribed waiters still let the owner run.
+inline void spin_until(const std::atomic<bool>& flag, const bool value) {
+  for (int spin = 0; flag.load(std::memory_order_acquire) != value; ++spin) {
+    if (spin < 128) {
+#if CDS_SIMD_X86
+      _mm_pause();
+#endif
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace detail
+
+/// @brief An MCS queue lock (Mellor-Crummey & Scott, 1991). Waiters form a
+/// FIFO queue and each spins on a flag in its own node, so a release writes
+/// exactly one waiter's cache line and ownership passes in arrival order.
+/// Meets the Lockable requirements, so std::lock_guard, std::unique_lock and
+/// std::scoped_lock work as usual; nodes come from a per-thread pool.
+class mcs_lock {
+ public:
+  mcs_lock() = default;
+  mcs_lock(const mcs_lock&) = delete;
+  mcs_lock& operator=(const mcs_lock&) = delete;
+
+  /// @brief Joins the queue and waits for the previous owner to hand over.
+  void lock() {
+    detail::queue_node* node = detail::queue_node_pool::acquire();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    node->locked.store(true, std::memory_order_relaxed);
+
+    detail::queue_node* pred = tail_.exchange(node, std::memory_order_acq_rel);
+    if (pred) {
+      pred->next.store(node, std::memory_order_release);
+      detail::spin_until(node->locked, false);
+    }
+    owner_ = node;
+  }
+
+  /// @brief Acquires the lock only if nobody holds or waits for it.
+  /// @return true if the lock was acquired.
+  bool try_lock() {
+    detail::queue_node* node = detail::queue_node_pool::acquire();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    detail::queue_node* expected = nullptr;
+    if (!tail_.compare_exchange_strong(expected, node,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+      detail::queue_node_pool::release(node);
+      return false;
+    }
+    owner_ = node;
+    return true;
+  }
+
+  /// @brief Hands the lock to the next waiter, if any.
+  void unlock() {
+    detail::queue_node* node = owner_;
+    detail::queue_node* next = node->next.load(std::memory_order_acquire);
+    if (!next) {
+      detail::queue_node* expected = node;
+      if (tail_.compare_exchange_strong(expected, nullptr,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+        detail::queue_node_pool::release(node);
+        return;
+      }
+      // A waiter swapped itself in but has not linked itself yet.
+      while (!(next = node->next.load(std::memory_order_acquire))) {
+#if CDS_SIMD_X86
+        _mm_pause();
+#endif
+      }
+    }
+    next->locked.store(false, std::memory_order_release);
+    detail::queue_node_pool::release(node);
+  }
+
+ private:
+  alignas(64) std::atomic<detail::queue_node*> tail_{nullptr};
+  // Only read and written by the owner.
+  detail::queue_node* owner_ = nullptr;
+};
+
+/// @brief A CLH queue lock (Craig; Landin & Hagersten). Each waiter spins on
+/// its predecessor's node, which only the predecessor writes, and ownership
+/// passes in arrival order. Unlike MCS, the release is a single store with
+/// no compare-and-swap. Meets the BasicLockable requirements only: a waiter
+/// cannot leave the queue, so there is no try_lock().
+class clh_lock {
+ public:
+  clh_lock() : tail_(new detail::queue_node) {}
+  clh_lock(const clh_lock&) = delete;
+  clh_lock& operator=(const clh_lock&) = delete;
+
+  /// @brief Frees the node at the tail of the queue. The lock must be free.
+  ~clh_lock() { delete tail_.load(std::memory_order_relaxed); }
+
+  /// @brief Joins the queue and waits for the predecessor to release.
+  void lock() {
+    detail::queue_node* node = detail::queue_node_pool::acquire();
+    node->locked.store(true, std::memory_order_relaxed);
+    detail::queue_node* pred = tail_.exchange(node, std::memory_order_acq_rel);
+    detail::spin_until(pred->locked, false);
+    owner_ = node;
+    pred_ = pred;
+  }
+
+  /// @brief Releases the lock to the next waiter, if any.
+  void unlock() {
+    // The successor now owns this thread's node; the predecessor's node is
+    // no longer referenced by anyone and is recycled instead.
+    detail::queue_node* pred = pred_;
+    owner_->locked.store(false, std::memory_order_release);
+    detail::queue_node_pool::release(pred);
+  }
+
+ private:
+  alignas(64) std::atomic<detail::queue_node*> tail_;
+  // Only read and written by the owner.
+  detail::queue_node* owner_ = nullptr;
+  detail::queue_node* pred_ = nullptr;
+};
+
+/// @brief A SharedMutex whose writers first line up in a queue lock, so that
+/// at most one writer at a time competes with readers for the underlying
+/// lock and writers are served in FIFO order. Readers use the underlying
+/// lock directly. Use it as the Mutex parameter of cds_array or cds_vector.
+/// @tparam QueueLock mcs_lock or clh_lock. try_lock() is only available
+/// when QueueLock has one.
+/// @tparam Shared The underlying SharedMutex.
+template <typename QueueLock, typename Shared = std::shared_mutex>
+class queued_shared_mutex {
+ public:
+  queued_shared_mutex() = default;
+  queued_shared_mutex(const queued_shared_mutex&) = delete;
+  queued_shared_mutex& operator=(const queued_shared_mutex&) = delete;
+
+  /// @brief Waits for earlier writers, then for readers to leave.
+  void lock() {
+    writers_.lock();
+    shared_.lock();
+  }
+
+  /// @brief Acquires exclusive ownership only if it is free.
+  /// @return true if the lock was acquired.
+  bool try_lock() {
+    if (!writers_.try_lock()) {
+      return false;
+    }
+    if (!shared_.try_lock()) {
+      writers_.unlock();
+      return false;
+    }
+    return true;
+  }
+
+  /// @brief Releases exclusive ownership to the next queued writer.
+  void unlock() {
+    shared_.unlock();
+    writers_.unlock();
+  }
+
+  /// @brief Acquires shared ownership.
+  void lock_shared() { shared_.lock_shared(); }
+
+  /// @brief Tries to acquire shared ownership.
+  /// @return true if the lock was acquired.
+  bool try_lock_shared() { return shared_.try_lock_shared(); }
+
+  /// @brief Releases shared ownership.
+  void unlock_shared() { shared_.unlock_shared(); }
+
+ private:
+  QueueLock writers_;
+  Shared shared_;
+};
+
+/// @brief A scoped owner of an mcs_lock.
+using mcs_guard = std::lock_guard<mcs_lock>;
+/// @brief A scoped owner of a clh_lock.
+using clh_guard = std::lock_guard<clh_lock>;
+}  // namespace cds
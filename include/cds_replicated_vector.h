@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "cds_huge_page_allocator.h"
+#include "cds_numa.h"
+#include "cds_vector.h"
+
+namespace cds {
+
+/// @brief A read-mostly vector replicated across NUMA nodes, in the style of
+/// Node Replication. Each node keeps its own cds_vector replica. Writers
+/// append operations to a shared log, and a replica applies the log lazily
+/// when it is next read, so reads take only the local replica's lock. A
+/// replica's buffer is bound to its node once it reaches one page; smaller
+/// buffers come from operator new and are placed wherever the kernel puts
+/// them.
+/// @tparam T The type of object the vector will hold. It must be copyable,
+/// since every write is applied once per replica.
+template <typename T>
+class cds_replicated_vector {
+ public:
+  /// @brief The allocator used by each replica.
+  using allocator_type = huge_page_allocator<T>;
+  /// @brief The replica type.
+  using replica_type = cds_vector<T, allocator_type>;
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief cds_replicated_vector size type.
+  using size_type = std::size_t;
+
+  /// @brief The default log length after which writers bring every replica
+  /// up to date and truncate the log.
+  static constexpr size_type default_max_log = 1024;
+
+  /// @brief Constructs an empty vector.
+  /// @param replicas The number of replicas; 0 selects one per NUMA node.
+  /// When that node exists, replica i's buffer is bound to node i once it
+  /// reaches one page.
+  /// @param max_log The log length that triggers a full sync and truncation.
+  explicit cds_replicated_vector(size_type replicas = 0,
+                                 const size_type max_log = default_max_log)
+      : max_log_(max_log ? max_log : 1) {
+    const numa_topology& topology = numa_topology::instance();
+    replicas = replicas ? replicas : topology.node_count();
+    replicas_.reserve(replicas);
+    for (size_type i = 0; i < replicas; ++i) {
+      huge_page_options options;
+      options.pages = page_size::standard;
+      if (i < topology.node_count() && topology.node_count() > 1) {
+        options.placement = numa_placement::bind;
+        options.node = i;
+      }
+      replicas_.push_back(std::make_unique<replica>(allocator_type(options)));
+    }
+  }
+
+  cds_replicated_vector(const cds_replicated_vector&) = delete;
+  cds_replicated_vector& operator=(const cds_replicated_vector&) = delete;
+
+  /// @brief Appends value to the end of the vector.
+  /// @param value The value to append.
+  void push_back(const T& value) {
+    append_(op{op_kind::push_back, 0, value});
+  }
+
+  /// @brief Sets the value at position pos to value.
+  /// @param pos The position in the vector to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, const T& value) {
+    append_(op{op_kind::set, pos, value});
+  }
+
+  /// @brief Removes the element at position pos, shifting later elements
+  /// down by one.
+  /// @param pos The position of the element to remove.
+  void erase(const size_type pos) {
+    append_(op{op_kind::erase, pos, std::nullopt});
+  }
+
+  /// @brief Brings the local replica up to date and returns a copy of the
+  /// value at the specified position. Functionally equivalent to operator[].
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type at(const size_type pos) {
+    auto read = new_scoped_read();
+    return read.at(pos);
+  }
+
+  /// @brief Brings the local replica up to date and returns a copy of the
+  /// value at the specified position. Functionally equivalent to at().
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type operator[](const size_type pos) { return at(pos); }
+
+  /// @brief Brings the local replica up to date and returns its size.
+  /// @return The number of elements in the vector.
+  size_type size() { return new_scoped_read().size(); }
+
+  /// @brief Brings the calling thread's node replica up to date and returns
+  /// a scoped_read of it. The read sees every write that completed before
+  /// this call.
+  /// @return A new scoped_read instance for batch read operations.
+  typename replica_type::scoped_read new_scoped_read() {
+    replica& r = local_replica_();
+    catch_up_(r);
+    return r.vector.new_scoped_read();
+  }
+
+  /// @brief Brings the given replica up to date and returns a scoped_read
+  /// of it.
+  /// @param index The replica index, in [0, replica_count()).
+  /// @return A new scoped_read instance for batch read operations.
+  typename replica_type::scoped_read new_scoped_read(const size_type index) {
+    replica& r = *replicas_.at(index);
+    catch_up_(r);
+    return r.vector.new_scoped_read();
+  }
+
+  /// @brief Brings every replica up to date and truncates the log.
+  void sync() {
+    for (auto& r : replicas_) {
+      catch_up_(*r);
+    }
+    truncate_log_();
+  }
+
+  /// @brief Returns the number of replicas.
+  /// @return The number of replicas.
+  size_type replica_count() const noexcept { return replicas_.size(); }
+
+  /// @brief Returns the number of operations a replica has yet to apply.
+  /// @param index The replica index, in [0, replica_count()).
+  /// @return The replica's lag behind the log.
+  size_type replica_lag(const size_type index) const {
+    const replica& r = *replicas_.at(index);
+    return static_cast<size_type>(log_tail_.load(std::memory_order_acquire) -
+                                  r.applied.load(std::memory_order_acquire));
+  }
+
+ private:
+  enum class op_kind { push_back, set, erase };
+
+  struct op {
+    op_kind kind;
+    size_type pos;
+    std::optional<T> value;
+  };
+
+  struct alignas(64) replica {
+    explicit replica(const allocator_type& alloc) : vector(alloc) {}
+
+    replica_type vector;
+    std::atomic<std::uint64_t> applied{0};
+  };
+
+  std::vector<std::unique_ptr<replica>> replicas_;
+  size_type max_log_;
+
+  // The log holds operations [log_head_, log_tail_). logical_size_ is the
+  // size of the vector once every logged operation has been applied.
+  alignas(64) mutable std::shared_mutex log_mutex_;
+  std::deque<op> log_;
+  std::uint64_t log_head_ = 0;
+  size_type logical_size_ = 0;
+  std::atomic<std::uint64_t> log_tail_{0};
+
+  replica& local_replica_() noexcept {
+    const size_type node = numa_topology::instance().cached_current_node();
+    return *replicas_[node % replicas_.size()];
+  }
+
+  void append_(op&& operation) {
+    bool full = false;
+    {
+      std::lock_guard<std::shared_mutex> lock(log_mutex_);
+      switch (operation.kind) {
+        case op_kind::push_back:
+          ++logical_size_;
+          break;
+        case op_kind::set:
+          if (operation.pos >= logical_size_) {
+            throw std::out_of_range("element access out of range");
+          }
+          break;
+        case op_kind::erase:
+          if (operation.pos >= logical_size_) {
+            throw std::out_of_range("element access out of range");
+          }
+          --logical_size_;
+          break;
+      }
+      log_.push_back(std::move(operation));
+      log_tail_.fetch_add(1, std::memory_order_release);
+      full = log_.size() > max_log_;
+    }
+
+    // Apply locally so the writer reads its own write from its replica.
+    catch_up_(local_replica_());
+    if (full) {
+      sync();
+    }
+  }
+
+  void catch_up_(replica& r) {
+    if (r.applied.load(std::memory_order_acquire) ==
+        log_tail_.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    auto write = r.vector.new_scoped_write();
+    std::shared_lock<std::shared_mutex> log_lock(log_mutex_);
+    std::uint64_t applied = r.applied.load(std::memory_order_relaxed);
+    const std::uint64_t tail = log_tail_.load(std::memory_order_relaxed);
+    for (; applied < tail; ++applied) {
+      const op& operation = log_[applied - log_head_];
+      switch (operation.kind) {
+        case op_kind::push_back:
+          write.push_back(*operation.value);
+          break;
+        case op_kind::set:
+          write.at(operation.pos) = *operation.value;
+          break;
+        case op_kind::erase:
+          write.erase(operation.pos);
+          break;
+      }
+      // Published per operation, so that an operation that throws leaves
+      // every earlier one recorded and is retried alone next time.
+      r.applied.store(applied + 1, std::memory_order_release);
+    }
+  }
+
+  void truncate_log_() {
+    std::lock_guard<std::shared_mutex> lock(log_mutex_);
+    std::uint64_t oldest = log_tail_.load(std::memory_order_relaxed);
+    for (const auto& r : replicas_) {
+      oldest = std::min(oldest, r->applied.load(std::memory_order_acquire));
+    }
+    while (log_head_ < oldest) {
+      log_.pop_front();
+      ++log_head_;
+    }
+  }
+};
+}  // namespace cds
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace cds {
+
+/// @brief A contiguous span of bytes handed to a serialization writer,
+/// laid out like a POSIX iovec.
+struct io_slice {
+  /// @brief The first byte.
+  const void* data;
+  /// @brief The number of bytes.
+  std::size_t size;
+};
+
+/// @brief The header preceding every serialized container.
+struct serial_header {
+  /// @brief Identifies the data as a serialized cds container.
+  std::uint32_t magic;
+  /// @brief The serialization format version.
+  std::uint16_t format_version;
+  /// @brief sizeof(T) of the writer, checked on deserialization.
+  std::uint16_t element_size;
+  /// @brief The number of elements following the header.
+  std::uint64_t count;
+};
+
+/// @brief The default chunk size used by serialize_chunks().
+inline constexpr std::size_t default_serial_chunk = 1024 * 1024;
+
+namespace detail {
+
+inline constexpr std::uint32_t serial_magic = 0x53444343;  // "CCDS"
+inline constexpr std::uint16_t serial_format_version = 1;
+
+template <typename T>
+serial_header make_serial_header(const std::size_t count) noexcept {
+  static_assert(sizeof(T) <= UINT16_MAX, "element type is too large");
+  return serial_header{serial_magic, serial_format_version,
+                       static_cast<std::uint16_t>(sizeof(T)),
+                       static_cast<std::uint64_t>(count)};
+}
+
+/// @brief Emits the header and the raw elements in one writer call.
+template <typename T, typename Writer>
+void write_serialized(Writer& writer, const T* data, const std::size_t count) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "serialization requires a trivially copyable T");
+  const serial_header header = make_serial_header<T>(count);
+  const io_slice slices[] = {{&header, sizeof(header)},
+                             {data, count * sizeof(T)}};
+  writer(slices, count ? std::size_t(2) : std::size_t(1));
+}
+
+/// @brief Emits the header, then the raw elements in chunks of at most
+/// chunk_bytes, one writer call per chunk.
+template <typename T, typename Writer>
+void write_serialized_chunks(Writer& writer, const T* data,
+                             const std::size_t count,
+                             const std::size_t chunk_bytes) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "serialization requires a trivially copyable T");
+  if (chunk_bytes == 0) {
+    throw std::invalid_argument("serialization chunk size must be non-zero");
+  }
+
+  const serial_header header = make_serial_header<T>(count);
+  const io_slice header_slice{&header, sizeof(header)};
+  writer(&header_slice, std::size_t(1));
+
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  for (std::size_t left = count * sizeof(T); left;) {
+    const io_slice chunk{bytes, std::min(left, chunk_bytes)};
+    writer(&chunk, std::size_t(1));
+    bytes += chunk.size;
+    left -= chunk.size;
+  }
+}
+
+/// @brief Reads and validates a header, returning the element count.
+template <typename T, typename Reader>
+std::size_t read_serial_header(Reader& reader) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "serialization requires a trivially copyable T");
+  serial_header header{};
+  reader(&header, sizeof(header));
+  if (header.magic != serial_magic) {
+    throw std::runtime_error("not a serialized cds container");
+  }
+  if (header.format_version != serial_format_version) {
+    throw std::runtime_error("unsupported serialization format version");
+  }
+  if (header.element_size != sizeof(T)) {
+    throw std::runtime_error("serialized element size mismatch");
+  }
+  return static_cast<std::size_t>(header.count);
+}
+
+}  // namespace detail
+
+#if defined(__unix__) || defined(__APPLE__)
+/// @brief A serialization writer that sends slices to a file descriptor with
+/// writev, retrying partial writes.
+struct fd_writer {
+  /// @brief The destination file descriptor.
+  int fd;
+
+  /// @brief Writes every byte of the given slices.
+  /// @param slices The slices to write.
+  /// @param count The number of slices.
+  void operator()(const io_slice* slices, std::size_t count) const {
+    static_assert(sizeof(io_slice) == sizeof(iovec),
+                  "io_slice must match iovec");
+    iovec vecs[2];
+    while (count) {
+      const std::size_t batch = std::min<std::size_t>(count, 2);
+      std::size_t left = 0;
+      for (std::size_t i = 0; i < batch; ++i) {
+        vecs[i].iov_base = const_cast<void*>(slices[i].data);
+        vecs[i].iov_len = slices[i].size;
+        left += slices[i].size;
+      }
+
+      iovec* pending = vecs;
+      int pending_count = static_cast<int>(batch);
+      while (left) {
+        const ssize_t written = ::writev(fd, pending, pending_count);
+        if (written < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throw std::system_error(errno, std::generic_category(),
+                                  "writev failed");
+        }
+
+        left -= static_cast<std::size_t>(written);
+        for (std::size_t done = static_cast<std::size_t>(written); done;) {
+          const std::size_t step = std::min(done, pending->iov_len);
+          pending->iov_base = static_cast<char*>(pending->iov_base) + step;
+          pending->iov_len -= step;
+          done -= step;
+          if (pending->iov_len == 0) {
+            ++pending;
+            --pending_count;
+          }
+        }
+      }
+      slices += batch;
+      count -= batch;
+    }
+  }
+};
+
+/// @brief A serialization reader that fills buffers from a file descriptor,
+/// retrying partial reads.
+struct fd_reader {
+  /// @brief The source file descriptor.
+  int fd;
+
+  /// @brief Reads exactly bytes bytes into dst.
+  /// @param dst The destination buffer.
+  /// @param bytes The number of bytes to read.
+  void operator()(void* dst, std::size_t bytes) const {
+    char* out = static_cast<char*>(dst);
+    while (bytes) {
+      const ssize_t n = ::read(fd, out, bytes);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "read failed");
+      }
+      if (n == 0) {
+        throw std::runtime_error("unexpected end of serialized data");
+      }
+      out += n;
+      bytes -= static_cast<std::size_t>(n);
+    }
+  }
+};
+#endif
+
+}  // namespace cds
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "cds_shared_array requires POSIX shared memory"
+#endif
+
+namespace cds {
+
+namespace detail {
+
+inline void check_pthread(const int result, const char* what) {
+  if (result != 0) {
+    throw std::system_error(result, std::generic_category(), what);
+  }
+}
+
+}  // namespace detail
+
+/// @brief A thread- and process-safe static array that can live in POSIX
+/// shared memory. It holds no pointers, only a process-shared
+/// pthread_rwlock and the elements, so every process that maps it can use it
+/// at whatever address the mapping lands. Use it through shm_object.
+/// @tparam T The type of object the array will hold. It must be trivially
+/// copyable, so no element refers to memory of a single process.
+/// @tparam N The number of elements the array will hold.
+/// @warning A process that dies while holding the lock leaves it held.
+template <typename T, std::size_t N>
+class cds_shared_array {
+  static_assert(N, "cds_shared_array does not support empty arrays");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "cds_shared_array requires a trivially copyable T");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Reference to T.
+  using reference = T&;
+  /// @brief Const reference to T.
+  using const_reference = const T&;
+  /// @brief cds_shared_array size type.
+  using size_type = std::size_t;
+
+  /// @brief A convenience struct which acquires a write lock for the target
+  /// array and exposes an interface for batch writes. Unlike
+  /// cds_shared_array, these functions do not acquire a lock at each write.
+  /// @warning This interface exposes non-const references, which can be used
+  /// outside the scope of the lock.
+  struct scoped_write {
+    /// @brief Construct a new scoped_write.
+    /// @param arr The input array to build the scoped_write object for.
+    explicit scoped_write(cds_shared_array& arr) : array_(arr) {
+      detail::check_pthread(pthread_rwlock_wrlock(&array_.lock_),
+                            "pthread_rwlock_wrlock failed");
+    }
+    scoped_write(const scoped_write&) = delete;
+    scoped_write& operator=(const scoped_write&) = delete;
+
+    /// @brief Releases the write lock.
+    ~scoped_write() { pthread_rwlock_unlock(&array_.lock_); }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference at(const size_type pos) {
+      if (pos >= N) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return array_.buffer_[pos];
+    }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+   private:
+    cds_shared_array& array_;
+  };
+
+  /// @brief A convenience struct which acquires a read lock for the target
+  /// array and exposes an interface for batch reads. Unlike
+  /// cds_shared_array, these functions do not acquire a lock at each read.
+  struct scoped_read {
+    /// @brief Construct a new scoped_read.
+    /// @param arr The input array to build the scoped_read object for.
+    explicit scoped_read(const cds_shared_array& arr) : array_(arr) {
+      detail::check_pthread(pthread_rwlock_rdlock(&array_.lock_),
+                            "pthread_rwlock_rdlock failed");
+    }
+    scoped_read(const scoped_read&) = delete;
+    scoped_read& operator=(const scoped_read&) = delete;
+
+    /// @brief Releases the read lock.
+    ~scoped_read() { pthread_rwlock_unlock(&array_.lock_); }
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference at(const size_type pos) const {
+      if (pos >= N) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return array_.buffer_[pos];
+    }
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference operator[](const size_type pos) const { return at(pos); }
+
+   private:
+    const cds_shared_array& array_;
+  };
+
+  /// @brief Constructs an array of value-initialized elements with a
+  /// process-shared lock.
+  cds_shared_array() : buffer_{} {
+    pthread_rwlockattr_t attr;
+    detail::check_pthread(pthread_rwlockattr_init(&attr),
+                          "pthread_rwlockattr_init failed");
+    const int shared =
+        pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    const int init = shared ? shared : pthread_rwlock_init(&lock_, &attr);
+    pthread_rwlockattr_destroy(&attr);
+    detail::check_pthread(init, "process-shared rwlock unavailable");
+  }
+
+  cds_shared_array(const cds_shared_array&) = delete;
+  cds_shared_array& operator=(const cds_shared_array&) = delete;
+
+  /// @brief Destroys the lock. Only the process that created the array
+  /// should destroy it, once no other process uses it.
+  ~cds_shared_array() { pthread_rwlock_destroy(&lock_); }
+
+  /// @brief Returns a new scoped_write from this array for batch write
+  /// operations.
+  /// @return A new scoped_write instance for batch write operations.
+  scoped_write new_scoped_write() { return scoped_write(*this); }
+
+  /// @brief Returns a new scoped_read from this array for batch read
+  /// operations.
+  /// @return A new scoped_read instance for batch read operations.
+  scoped_read new_scoped_read() const { return scoped_read(*this); }
+
+  /// @brief Acquires a write lock and sets the value at position pos to value.
+  /// @param pos The position in the array to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, const_reference value) {
+    scoped_write write(*this);
+    write.at(pos) = value;
+  }
+
+  /// @brief Acquires a write lock and fills the array with the specified value.
+  /// @param value The value to fill the array with.
+  void fill(const_reference value) {
+    scoped_write write(*this);
+    std::fill(buffer_, buffer_ + N, value);
+  }
+
+  /// @brief Acquires a read lock and returns a copy of the value at the
+  /// specified position. Functionally equivalent to operator[].
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type at(const size_type pos) const {
+    scoped_read read(*this);
+    return read.at(pos);
+  }
+
+  /// @brief Acquires a read lock and returns a copy of the value at the
+  /// specified position. Functionally equivalent to at().
+  /// @param pos The specified position.
+  /// @return A copy of the value at position pos.
+  value_type operator[](const size_type pos) const { return at(pos); }
+
+  /// @brief Acquires a read lock and copies count elements starting at
+  /// position first into out, so readers can take a consistent snapshot of a
+  /// range with a single lock acquisition.
+  /// @param first The first position to copy.
+  /// @param count The number of elements to copy.
+  /// @param out The destination buffer.
+  void copy_out(const size_type first, const size_type count, T* out) const {
+    if (first > N || count > N - first) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    scoped_read read(*this);
+    std::copy(buffer_ + first, buffer_ + first + count, out);
+  }
+
+  /// @brief Returns the size of the array. This is equivalent to template
+  /// parameter N.
+  /// @return The size of the array.
+  constexpr size_type size() const noexcept { return N; }
+
+ private:
+  mutable pthread_rwlock_t lock_;
+  T buffer_[N];
+};
+
+/// @brief Owns a mapping of a POSIX shared memory object holding a single
+/// Object, such as a cds_shared_array. The creating process constructs the
+/// object and, on destruction, destroys and unlinks it; other processes open
+/// it by name and see the same object at their own mapping address.
+/// @tparam Object The type placed in shared memory. It must not contain
+/// pointers.
+template <typename Object>
+class shm_object {
+ public:
+  /// @brief Creates the shared memory object name, which must not exist yet,
+  /// and constructs an Object in it.
+  /// @param name The POSIX shared memory name, e.g. "/my-table".
+  /// @param args The arguments forwarded to Object's constructor.
+  /// @return The owning handle.
+  template <typename... Args>
+  static shm_object create(const std::string& name, Args&&... args) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+      throw_errno("shm_open failed");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(sizeof(segment))) != 0) {
+      const int error = errno;
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      errno = error;
+      throw_errno("ftruncate failed");
+    }
+
+    shm_object handle(name, map(fd, name, true), true);
+    try {
+      ::new (static_cast<void*>(&handle.segment_->object))
+          Object(std::forward<Args>(args)...);
+    } catch (...) {
+      handle.owner_ = false;
+      ::shm_unlink(name.c_str());
+      throw;
+    }
+    handle.segment_->ready.store(1, std::memory_order_release);
+    return handle;
+  }
+
+  /// @brief Opens the shared memory object name, created by another process
+  /// with create(), and waits until its Object is constructed.
+  /// @param name The POSIX shared memory name.
+  /// @param timeout How long to wait for the creator to size the object and
+  /// construct the Object before giving up.
+  /// @return The non-owning handle.
+  template <typename Rep, typename Period>
+  static shm_object open(const std::string& name,
+                         const std::chrono::duration<Rep, Period>& timeout) {
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            timeout);
+
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      throw_errno("shm_open failed");
+    }
+
+    // The creator may not have called ftruncate yet.
+    for (;;) {
+      struct stat st {};
+      if (::fstat(fd, &st) != 0) {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        throw_errno("fstat failed");
+      }
+      if (st.st_size >= off_t(sizeof(segment))) {
+        break;
+      }
+      if (std::chrono::steady_clock::now() >= deadline) {
+        ::close(fd);
+        throw std::runtime_error("shared memory object is too small");
+      }
+      std::this_thread::yield();
+    }
+
+    // The creator may have died or its constructor may have thrown, in which
+    // case ready is never set.
+    shm_object handle(name, map(fd, name, false), false);
+    while (!handle.segment_->ready.load(std::memory_order_acquire)) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        throw std::runtime_error("shared memory object was never constructed");
+      }
+      std::this_thread::yield();
+    }
+    return handle;
+  }
+
+  /// @brief Opens the shared memory object name, waiting up to
+  /// default_open_timeout for it to be constructed.
+  /// @param name The POSIX shared memory name.
+  /// @return The non-owning handle.
+  static shm_object open(const std::string& name) {
+    return open(name, default_open_timeout);
+  }
+
+  /// @brief The timeout used by open(name).
+  static constexpr std::chrono::seconds default_open_timeout{5};
+
+  /// @brief Move constructor.
+  /// @param other The source handle, which is left empty.
+  shm_object(shm_object&& other) noexcept
+      : name_(std::move(other.name_)),
+        segment_(std::exchange(other.segment_, nullptr)),
+        owner_(std::exchange(other.owner_, false)) {}
+
+  shm_object(const shm_object&) = delete;
+  shm_object& operator=(const shm_object&) = delete;
+  shm_object& operator=(shm_object&&) = delete;
+
+  /// @brief Unmaps the object. The creating handle also destroys the Object
+  /// and unlinks the name; processes that still map it keep their mapping.
+  ~shm_object() {
+    if (!segment_) {
+      return;
+    }
+    if (owner_) {
+      segment_->object.~Object();
+      ::shm_unlink(name_.c_str());
+    }
+    ::munmap(segment_, sizeof(segment));
+  }
+
+  /// @brief Returns the shared Object.
+  /// @return A reference to the Object.
+  Object& operator*() const noexcept { return segment_->object; }
+
+  /// @brief Returns the shared Object.
+  /// @return A pointer to the Object, valid in this process only.
+  Object* operator->() const noexcept { return &segment_->object; }
+
+  /// @brief Returns the shared memory name.
+  /// @return The name passed to create() or open().
+  const std::string& name() const noexcept { return name_; }
+
+ private:
+  struct segment {
+    std::atomic<std::uint32_t> ready;
+    alignas(64) Object object;
+  };
+
+  std::string name_;
+  segment* segment_;
+  bool owner_;
+
+  shm_object(std::string name, segment* seg, const bool owner)
+      : name_(std::move(name)), segment_(seg), owner_(owner) {}
+
+  [[noreturn]] static void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  static segment* map(const int fd, const std::string& name,
+                      const bool owner) {
+    void* p = ::mmap(nullptr, sizeof(segment), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      if (owner) {
+        ::shm_unlink(name.c_str());
+      }
+      errno = error;
+      throw_errno("mmap failed");
+    }
+    return static_cast<segment*>(p);
+  }
+};
+}  // namespace cds
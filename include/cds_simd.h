@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define CDS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define CDS_SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CDS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CDS_TARGET(isa)
+#endif
+
+namespace cds {
+
+/// @brief The instruction set used by the bulk kernels.
+enum class simd_level {
+  /// @brief Portable scalar loops.
+  scalar,
+  /// @brief 128-bit SSE2 kernels.
+  sse2,
+  /// @brief 256-bit AVX2 kernels.
+  avx2,
+  /// @brief 512-bit AVX-512 (F and BW) kernels.
+  avx512,
+};
+
+namespace detail {
+
+/// @brief Queries the CPU (and OS register support) for the best level.
+/// @return The best simd_level supported at runtime.
+inline simd_level detect_simd_level() noexcept {
+#if CDS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return simd_level::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_level::avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return simd_level::sse2;
+  }
+#elif CDS_SIMD_X86 && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  __cpuid(info, 1);
+  const bool sse2 = info[3] & (1 << 26);
+  const bool osxsave = info[2] & (1 << 27);
+  const bool avx = info[2] & (1 << 28);
+  if (osxsave && avx && max_leaf >= 7) {
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = info[1] & (1 << 5);
+    const bool avx512 = (info[1] & (1 << 16)) && (info[1] & (1 << 30));
+    if (avx512 && (xcr0 & 0xe6) == 0xe6) {
+      return simd_level::avx512;
+    }
+    if (avx2 && (xcr0 & 0x6) == 0x6) {
+      return simd_level::avx2;
+    }
+  }
+  if (sse2) {
+    return simd_level::sse2;
+  }
+#endif
+  return simd_level::scalar;
+}
+
+inline unsigned simd_ctz(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+  unsigned n = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline unsigned simd_popcount(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+  unsigned n = 0;
+  for (; x; x &= x - 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
+
+/// @brief Folds a match mask into a scan result.
+/// @tparam Count If true, accumulate matches; otherwise stop at the first.
+/// @param mask The match mask, with Width bits per element.
+/// @param base The index of the first element covered by mask.
+/// @param width The number of mask bits per element.
+/// @param result The running count, or the found index.
+/// @return true if the scan is finished.
+template <bool Count>
+inline bool simd_fold(const std::uint64_t mask, const std::size_t base,
+                      const unsigned width, std::size_t& result) noexcept {
+  if (!mask) {
+    return false;
+  }
+
+  if constexpr (Count) {
+    result += simd_popcount(mask) / width;
+    return false;
+  } else {
+    result = base + simd_ctz(mask) / width;
+    return true;
+  }
+}
+
+/// @brief Scans the tail of a buffer one element at a time.
+template <bool Count, typename T>
+std::size_t scan_scalar(const T* data, std::size_t i, const std::size_t n,
+                        const T& value, std::size_t result) noexcept {
+  for (; i < n; ++i) {
+    if (data[i] == value) {
+      if constexpr (Count) {
+        ++result;
+      } else {
+        return i;
+      }
+    }
+  }
+  return Count ? result : n;
+}
+
+#if CDS_SIMD_X86
+template <typename T>
+CDS_TARGET("sse2")
+inline __m128i sse2_set1(const T value) noexcept {
+  if constexpr (sizeof(T) == 1) {
+    std::int8_t bits;
+    std::memcpy(&bits, &value, 1);
+    return _mm_set1_epi8(bits);
+  } else if constexpr (sizeof(T) == 2) {
+    std::int16_t bits;
+    std::memcpy(&bits, &value, 2);
+    return _mm_set1_epi16(bits);
+  } else if constexpr (sizeof(T) == 4) {
+    std::int32_t bits;
+    std::memcpy(&bits, &value, 4);
+    return _mm_set1_epi32(bits);
+  } else {
+    std::int64_t bits;
+    std::memcpy(&bits, &value, 8);
+    return _mm_set1_epi64x(bits);
+  }
+}
+
+template <typename T>
+CDS_TARGET("sse2")
+inline __m128i sse2_cmpeq(const __m128i a, const __m128i b) noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a),
+                                         _mm_castsi128_ps(b)));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a),
+                                         _mm_castsi128_pd(b)));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_cmpeq_epi32(a, b);
+  } else {
+    // SSE2 has no 64-bit compare; both 32-bit halves must match.
+    const __m128i halves = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(halves,
+                         _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+}
+
+template <bool Count, typename T>
+CDS_TARGET("sse2")
+std::size_t scan_sse2(const T* data, const std::size_t n,
+                      const T value) noexcept {
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  const __m128i needle = sse2_set1(value);
+  std::size_t result = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const std::uint64_t mask = static_cast<unsigned>(
+        _mm_movemask_epi8(sse2_cmpeq<T>(block, needle)));
+    if (simd_fold<Count>(mask, i, sizeof(T), result)) {
+      return result;
+    }
+  }
+  return scan_scalar<Count>(data, i, n, value, result);
+}
+
+template <typename T>
+CDS_TARGET("avx2")
+inline __m256i avx2_set1(const T value) noexcept {
+  if constexpr (sizeof(T) == 1) {
+    std::int8_t bits;
+    std::memcpy(&bits, &value, 1);
+    return _mm256_set1_epi8(bits);
+  } else if constexpr (sizeof(T) == 2) {
+    std::int16_t bits;
+    std::memcpy(&bits, &value, 2);
+    return _mm256_set1_epi16(bits);
+  } else if constexpr (sizeof(T) == 4) {
+    std::int32_t bits;
+    std::memcpy(&bits, &value, 4);
+    return _mm256_set1_epi32(bits);
+  } else {
+    std::int64_t bits;
+    std::memcpy(&bits, &value, 8);
+    return _mm256_set1_epi64x(bits);
+  }
+}
+
+template <typename T>
+CDS_TARGET("avx2")
+inline __m256i avx2_cmpeq(const __m256i a, const __m256i b) noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_cmp_ps(
+        _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(
+        _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_cmpeq_epi32(a, b);
+  } else {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+}
+
+template <bool Count, typename T>
+CDS_TARGET("avx2")
+std::size_t scan_avx2(const T* data, const std::size_t n,
+                      const T value) noexcept {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  const __m256i needle = avx2_set1(value);
+  std::size_t result = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const std::uint64_t mask = static_cast<unsigned>(
+        _mm256_movemask_epi8(avx2_cmpeq<T>(block, needle)));
+    if (simd_fold<Count>(mask, i, sizeof(T), result)) {
+      return result;
+    }
+  }
+  return scan_scalar<Count>(data, i, n, value, result);
+}
+
+template <typename T>
+CDS_TARGET("avx512f,avx512bw")
+inline std::uint64_t avx512_cmpeq(const __m512i a, const T value) noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_set1_ps(value),
+                              _CMP_EQ_OQ);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_set1_pd(value),
+                              _CMP_EQ_OQ);
+  } else if constexpr (sizeof(T) == 1) {
+    std::int8_t bits;
+    std::memcpy(&bits, &value, 1);
+    return _mm512_cmpeq_epi8_mask(a, _mm512_set1_epi8(bits));
+  } else if constexpr (sizeof(T) == 2) {
+    std::int16_t bits;
+    std::memcpy(&bits, &value, 2);
+    return _mm512_cmpeq_epi16_mask(a, _mm512_set1_epi16(bits));
+  } else if constexpr (sizeof(T) == 4) {
+    std::int32_t bits;
+    std::memcpy(&bits, &value, 4);
+    return _mm512_cmpeq_epi32_mask(a, _mm512_set1_epi32(bits));
+  } else {
+    std::int64_t bits;
+    std::memcpy(&bits, &value, 8);
+    return _mm512_cmpeq_epi64_mask(a, _mm512_set1_epi64(bits));
+  }
+}
+
+template <bool Count, typename T>
+CDS_TARGET("avx512f,avx512bw")
+std::size_t scan_avx512(const T* data, const std::size_t n,
+                        const T value) noexcept {
+  constexpr std::size_t lanes = 64 / sizeof(T);
+  std::size_t result = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const __m512i block = _mm512_loadu_si512(data + i);
+    if (simd_fold<Count>(avx512_cmpeq(block, value), i, 1, result)) {
+      return result;
+    }
+  }
+  return scan_scalar<Count>(data, i, n, value, result);
+}
+
+CDS_TARGET("sse2")
+inline void swap_bytes_sse2(unsigned char* a, unsigned char* b,
+                            const std::size_t bytes) noexcept {
+  for (std::size_t i = 0; i < bytes; i += 16) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), y);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), x);
+  }
+}
+
+CDS_TARGET("avx2")
+inline void swap_bytes_avx2(unsigned char* a, unsigned char* b,
+                            const std::size_t bytes) noexcept {
+  for (std::size_t i = 0; i < bytes; i += 32) {
+    const __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i y =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), y);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), x);
+  }
+}
+
+CDS_TARGET("avx512f,avx512bw")
+inline void swap_bytes_avx512(unsigned char* a, unsigned char* b,
+                              const std::size_t bytes) noexcept {
+  for (std::size_t i = 0; i < bytes; i += 64) {
+    const __m512i x = _mm512_loadu_si512(a + i);
+    const __m512i y = _mm512_loadu_si512(b + i);
+    _mm512_storeu_si512(a + i, y);
+    _mm512_storeu_si512(b + i, x);
+  }
+}
+#endif
+
+/// @brief Returns the best simd_level of this machine, detected once.
+/// @return The simd_level used by the bulk kernels.
+inline simd_level active_simd_level() noexcept {
+  static const simd_level level = detect_simd_level();
+  return level;
+}
+
+/// @brief Scans data for value with the kernel of the given level.
+/// @tparam Count If true, count matches; otherwise find the first one.
+/// @param level The kernel to use; must be supported by the CPU.
+/// @param data The buffer to scan.
+/// @param n The number of elements in data.
+/// @param value The value to look for.
+/// @return The match count, or the index of the first match (n if none).
+template <bool Count, typename T>
+std::size_t simd_scan(const simd_level level, const T* data,
+                      const std::size_t n, const T& value) noexcept {
+#if CDS_SIMD_X86
+  if constexpr (std::is_arithmetic_v<T> &&
+                (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                 sizeof(T) == 8)) {
+    switch (level) {
+      case simd_level::avx512:
+        return scan_avx512<Count>(data, n, value);
+      case simd_level::avx2:
+        return scan_avx2<Count>(data, n, value);
+      case simd_level::sse2:
+        return scan_sse2<Count>(data, n, value);
+      default:
+        break;
+    }
+  }
+#else
+  (void)level;
+#endif
+  return scan_scalar<Count>(data, 0, n, value, 0);
+}
+
+/// @brief Returns the index of the first element equal to value, using the
+/// best kernel available at runtime.
+/// @return The index of the first match, or n if there is none.
+template <typename T>
+std::size_t simd_find(const T* data, const std::size_t n,
+                      const T& value) noexcept {
+  return simd_scan<false>(active_simd_level(), data, n, value);
+}
+
+/// @brief Returns the number of elements equal to value, using the best
+/// kernel available at runtime.
+/// @return The number of matches.
+template <typename T>
+std::size_t simd_count(const T* data, const std::size_t n,
+                       const T& value) noexcept {
+  return simd_scan<true>(active_simd_level(), data, n, value);
+}
+
+/// @brief Compares two buffers element-wise. Integral buffers are compared
+/// with memcmp, which the C library already vectorizes.
+/// @return true if every element of a equals the matching element of b.
+template <typename T>
+bool simd_equal(const T* a, const T* b, const std::size_t n) noexcept {
+  if constexpr (std::is_integral_v<T>) {
+    return std::memcmp(a, b, n * sizeof(T)) == 0;
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!(a[i] == b[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+/// @brief Swaps n elements of a with the matching elements of b with the
+/// kernel of the given level. Arithmetic buffers are swapped as raw bytes,
+/// a vector at a time; other types use std::swap_ranges.
+/// @param level The kernel to use; must be supported by the CPU.
+/// @param a The first buffer.
+/// @param b The second buffer, which must not overlap a.
+/// @param n The number of elements in each buffer.
+template <typename T>
+void simd_swap_ranges(const simd_level level, T* a, T* b,
+                      const std::size_t n) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    unsigned char* x = reinterpret_cast<unsigned char*>(a);
+    unsigned char* y = reinterpret_cast<unsigned char*>(b);
+    const std::size_t bytes = n * sizeof(T);
+    std::size_t body = 0;
+#if CDS_SIMD_X86
+    switch (level) {
+      case simd_level::avx512:
+        body = bytes / 64 * 64;
+        swap_bytes_avx512(x, y, body);
+        break;
+      case simd_level::avx2:
+        body = bytes / 32 * 32;
+        swap_bytes_avx2(x, y, body);
+        break;
+      case simd_level::sse2:
+        body = bytes / 16 * 16;
+        swap_bytes_sse2(x, y, body);
+        break;
+      default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    std::swap_ranges(x + body, x + bytes, y + body);
+  } else {
+    (void)level;
+    std::swap_ranges(a, a + n, b);
+  }
+}
+
+/// @brief Swaps n elements of a with the matching elements of b, using the
+/// best kernel available at runtime.
+template <typename T>
+void simd_swap(T* a, T* b, const std::size_t n) {
+  simd_swap_ranges(active_simd_level(), a, b, n);
+}
+
+}  // namespace detail
+}  // namespace cds
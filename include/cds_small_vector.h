@@ -0,0 +1,426 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cds {
+
+/// @brief A thread-safe dynamic array that stores up to InlineN elements
+/// inside the object itself and only allocates from Allocator beyond that.
+/// It offers the same locking interface as cds_vector.
+/// @tparam T The type of object the vector will hold.
+/// @tparam InlineN The number of elements stored without allocating.
+/// @tparam Allocator The allocator used once the vector outgrows its inline
+/// storage. Its pointer type must be T*.
+template <typename T, std::size_t InlineN,
+          typename Allocator = std::allocator<T>>
+class cds_small_vector {
+  static_assert(InlineN, "cds_small_vector requires inline storage");
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::pointer, T*>,
+      "cds_small_vector requires an allocator with raw pointers");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Reference to T.
+  using reference = value_type&;
+  /// @brief Const reference to T.
+  using const_reference = const value_type&;
+  /// @brief Template parameter Allocator.
+  using allocator_type = Allocator;
+  /// @brief Pointer type.
+  using pointer = T*;
+  /// @brief Iterator type.
+  using iterator = pointer;
+  /// @brief Const iterator type.
+  using const_iterator = const T*;
+  /// @brief cds_small_vector size type.
+  using size_type = std::size_t;
+  /// @brief cds_small_vector difference type.
+  using difference_type = std::ptrdiff_t;
+
+  /// @brief A convenience struct which acquires a write lock for the target
+  /// vector and exposes an interface for batch writes. Unlike
+  /// cds_small_vector, these functions do not acquire a lock at each write.
+  /// @warning This interface exposes non-const references, which can be used
+  /// outside the scope of the lock.
+  struct scoped_write {
+    /// @brief Construct a new scoped_write.
+    /// @param vec The input vector to build the scoped_write object for.
+    explicit scoped_write(cds_small_vector& vec)
+        : vector_(vec), lock_(vec.mutex_) {}
+    scoped_write(const scoped_write&) = delete;
+    scoped_write& operator=(const scoped_write&) = delete;
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference at(const size_type pos) {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.start_[pos];
+    }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+    /// @brief Returns a reference to the value at the front of the vector.
+    /// @return A reference to the value at the front of the vector.
+    reference front() { return at(0); }
+
+    /// @brief Returns a reference to the value at the back of the vector.
+    /// @return A reference to the value at the back of the vector.
+    reference back() { return at(size() - 1); }
+
+    /// @brief Appends value to the end of the vector. References obtained
+    /// earlier may be invalidated.
+    /// @param value The value to append.
+    void push_back(const_reference value) {
+      vector_.emplace_back_unlocked_(value);
+    }
+
+    /// @brief Appends value to the end of the vector by moving it.
+    /// @param value The value to append.
+    void push_back(T&& value) {
+      vector_.emplace_back_unlocked_(std::move(value));
+    }
+
+    /// @brief Removes the element at the specified position, shifting later
+    /// elements down by one.
+    /// @param pos The position of the element to remove.
+    void erase(const size_type pos) { vector_.erase_unlocked_(pos); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_small_vector& vector_;
+    std::lock_guard<std::shared_mutex> lock_;
+  };
+
+  /// @brief A convenience struct which acquires a read lock for the target
+  /// vector and exposes an interface for batch reads. Unlike
+  /// cds_small_vector, these functions do not acquire a lock at each read.
+  struct scoped_read {
+    /// @brief Construct a new scoped_read.
+    /// @param vec The input vector to build the scoped_read object for.
+    explicit scoped_read(cds_small_vector& vec)
+        : vector_(vec), lock_(vec.mutex_) {}
+    scoped_read(const scoped_read&) = delete;
+    scoped_read& operator=(const scoped_read&) = delete;
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference at(const size_type pos) const {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.start_[pos];
+    }
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference operator[](const size_type pos) const { return at(pos); }
+
+    /// @brief Returns a const_reference to the value at the front of the
+    /// vector.
+    /// @return A const_reference to the value at the front of the vector.
+    const_reference front() const { return at(0); }
+
+    /// @brief Returns a const_reference to the value at the back of the vector.
+    /// @return A const_reference to the value at the back of the vector.
+    const_reference back() const { return at(size() - 1); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_small_vector& vector_;
+    std::shared_lock<std::shared_mutex> lock_;
+  };
+
+  /// @brief Constructs an empty cds_small_vector using its inline storage.
+  /// @param alloc The allocator used once the vector outgrows it.
+  explicit cds_small_vector(const Allocator& alloc = Allocator()) noexcept
+      : start_(inline_data_()),
+        end_(start_),
+        end_of_storage_(start_ + InlineN),
+        allocator_(alloc) {}
+
+  // The constructors below delegate to the allocator constructor, so if
+  // they throw after spilling to the heap, the destructor runs and releases
+  // the buffer; uninitialized_* has already destroyed the partial elements.
+
+  /// @brief Constructs a cds_small_vector with count copies of value.
+  /// @param count The number of elements.
+  /// @param value The value to set each element to.
+  /// @param alloc The allocator used once the vector outgrows its inline
+  /// storage.
+  cds_small_vector(const size_type count, const T& value,
+                   const Allocator& alloc = Allocator())
+      : cds_small_vector(alloc) {
+    reserve_unlocked_(count);
+    end_ = std::uninitialized_fill_n(start_, count, value);
+  }
+
+  /// @brief Constructs a cds_small_vector from the contents of the
+  /// initializer_list.
+  /// @param init The initializer list to copy from.
+  /// @param alloc The allocator used once the vector outgrows its inline
+  /// storage.
+  cds_small_vector(std::initializer_list<T> init,
+                   const Allocator& alloc = Allocator())
+      : cds_small_vector(alloc) {
+    reserve_unlocked_(init.size());
+    end_ = std::uninitialized_copy(init.begin(), init.end(), start_);
+  }
+
+  /// @brief Copy constructor. Locks & copies the contents of other.
+  /// @param other The source vector to copy from.
+  cds_small_vector(const cds_small_vector& other)
+      : cds_small_vector(std::allocator_traits<Allocator>::
+                             select_on_container_copy_construction(
+                                 other.allocator_)) {
+    std::shared_lock<std::shared_mutex> lock(other.mutex_);
+    reserve_unlocked_(other.size_unlocked_());
+    end_ = std::uninitialized_copy(other.start_, other.end_, start_);
+  }
+
+  /// @brief Move constructor. Locks other and takes over its heap buffer, or
+  /// moves its elements if they are stored inline.
+  /// @param other The source vector, which is left empty.
+  cds_small_vector(cds_small_vector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : cds_small_vector(other.allocator_) {
+    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    if (other.is_inline_unlocked_()) {
+      end_ = std::uninitialized_move(other.start_, other.end_, start_);
+      other.clear_unlocked_();
+    } else {
+      start_ = std::exchange(other.start_, other.inline_data_());
+      end_ = std::exchange(other.end_, other.start_);
+      end_of_storage_ =
+          std::exchange(other.end_of_storage_, other.start_ + InlineN);
+    }
+  }
+
+  cds_small_vector& operator=(const cds_small_vector&) = delete;
+  cds_small_vector& operator=(cds_small_vector&&) = delete;
+
+  /// @brief Destroys all objects and releases any heap storage.
+  ~cds_small_vector() {
+    clear_unlocked_();
+    release_unlocked_();
+  }
+
+  /// @brief Returns a new scoped_write from this vector for batch write
+  /// operations.
+  /// @return A new scoped_write instance for batch write operations.
+  scoped_write new_scoped_write() { return scoped_write(*this); }
+
+  /// @brief Returns a new scoped_read from this vector for batch read
+  /// operations.
+  /// @return A new scoped_read instance for batch read operations.
+  scoped_read new_scoped_read() { return scoped_read(*this); }
+
+  /// @brief Returns an iterator pointing to the start of the vector.
+  /// @warning begin() is not thread-safe by itself. Please acquire a
+  /// scoped_write to ensure thread safe iteration.
+  /// @return An iterator pointing to the start of the vector.
+  iterator begin() { return start_; }
+
+  /// @brief Returns an iterator pointing to the end of the vector.
+  /// @warning end() is not thread-safe by itself. Please acquire a
+  /// scoped_write to ensure thread safe iteration.
+  /// @return An iterator pointing to the end of the vector.
+  iterator end() { return end_; }
+
+  /// @brief Acquires a read lock and returns a const_reference to the value
+  /// at the specified position.
+  /// @param pos The specified position.
+  /// @return A const_reference to the value at position pos.
+  const_reference operator[](const size_type pos) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return start_[pos];
+  }
+
+  /// @brief Acquires a write lock and appends value to the end of the vector.
+  /// The vector moves to the heap once it outgrows its inline storage.
+  /// @param value The value to append.
+  void push_back(const_reference value) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    emplace_back_unlocked_(value);
+  }
+
+  /// @brief Acquires a write lock and appends value to the end of the vector
+  /// by moving it.
+  /// @param value The value to append.
+  void push_back(T&& value) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    emplace_back_unlocked_(std::move(value));
+  }
+
+  /// @brief Acquires a write lock and sets the value at position pos to value.
+  /// @param pos The position in the vector to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, const_reference value) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (pos >= size_unlocked_()) {
+      throw std::out_of_range("element access out of range");
+    }
+    start_[pos] = value;
+  }
+
+  /// @brief Acquires a write lock and removes the element at position pos,
+  /// shifting later elements down by one.
+  /// @param pos The position of the element to remove.
+  void erase(const size_type pos) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    erase_unlocked_(pos);
+  }
+
+  /// @brief Acquires a write lock and grows the capacity to at least
+  /// new_cap elements.
+  /// @param new_cap The minimum capacity.
+  void reserve(const size_type new_cap) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    reserve_unlocked_(new_cap);
+  }
+
+  /// @brief Checks if the container is empty.
+  /// @return true if empty, false otherwise.
+  bool empty() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return end_ == start_;
+  }
+
+  /// @brief Returns the number of elements in the container.
+  /// @return The number of elements in the container.
+  size_type size() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return size_unlocked_();
+  }
+
+  /// @brief Returns the total reserved capacity of the container, which is
+  /// InlineN while the elements are stored inline.
+  /// @return The reserved capacity of the container.
+  size_type capacity() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return end_of_storage_ - start_;
+  }
+
+  /// @brief Returns whether the elements are stored inline.
+  /// @return true if no heap storage is in use.
+  bool is_inline() const noexcept {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return is_inline_unlocked_();
+  }
+
+ private:
+  pointer start_;
+  pointer end_;
+  pointer end_of_storage_;
+  Allocator allocator_;
+  mutable std::shared_mutex mutex_;
+  alignas(T) unsigned char inline_[InlineN * sizeof(T)];
+
+  pointer inline_data_() noexcept { return reinterpret_cast<pointer>(inline_); }
+  const T* inline_data_() const noexcept {
+    return reinterpret_cast<const T*>(inline_);
+  }
+  bool is_inline_unlocked_() const noexcept { return start_ == inline_data_(); }
+  size_type size_unlocked_() const noexcept { return end_ - start_; }
+
+  void clear_unlocked_() noexcept {
+    for (pointer p = start_; p != end_; ++p) {
+      std::allocator_traits<Allocator>::destroy(allocator_, p);
+    }
+    end_ = start_;
+  }
+
+  void release_unlocked_() noexcept {
+    if (!is_inline_unlocked_()) {
+      std::allocator_traits<Allocator>::deallocate(allocator_, start_,
+                                                   end_of_storage_ - start_);
+    }
+  }
+
+  void reserve_unlocked_(const size_type new_cap) {
+    if (new_cap <= static_cast<size_type>(end_of_storage_ - start_)) {
+      return;
+    }
+
+    pointer start =
+        std::allocator_traits<Allocator>::allocate(allocator_, new_cap);
+    pointer end = start;
+    try {
+      for (pointer p = start_; p != end_; ++p, ++end) {
+        std::allocator_traits<Allocator>::construct(allocator_, end,
+                                                    std::move_if_noexcept(*p));
+      }
+    } catch (...) {
+      while (end != start) {
+        std::allocator_traits<Allocator>::destroy(allocator_, --end);
+      }
+      std::allocator_traits<Allocator>::deallocate(allocator_, start, new_cap);
+      throw;
+    }
+
+    clear_unlocked_();
+    release_unlocked_();
+    start_ = start;
+    end_ = end;
+    end_of_storage_ = start + new_cap;
+  }
+
+  template <typename... Args>
+  void emplace_back_unlocked_(Args&&... args) {
+    if (end_ != end_of_storage_) {
+      std::allocator_traits<Allocator>::construct(allocator_, end_,
+                                                  std::forward<Args>(args)...);
+      ++end_;
+      return;
+    }
+
+    // Copy the new element first, since args may refer into the storage
+    // that the reallocation is about to release.
+    T value(std::forward<Args>(args)...);
+    reserve_unlocked_(2 * size_unlocked_());
+    std::allocator_traits<Allocator>::construct(allocator_, end_,
+                                                std::move(value));
+    ++end_;
+  }
+
+  void erase_unlocked_(const size_type pos) {
+    if (pos >= size_unlocked_()) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    std::move(start_ + pos + 1, end_, start_ + pos);
+    --end_;
+    std::allocator_traits<Allocator>::destroy(allocator_, end_);
+  }
+};
+}  // namespace cds
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace cds {
+
+/// @brief A fixed-capacity vector with inline storage, like cds_array, but
+/// with a runtime size that grows by lock-free appends. Each append claims a
+/// slot with a single fetch_add, constructs the element in place and then
+/// publishes it through a per-slot flag, so readers never take a lock and
+/// only ever see fully constructed elements. Published elements are
+/// immutable.
+/// @tparam T The type of object the vector will hold.
+/// @tparam N The maximum number of elements.
+template <typename T, std::size_t N>
+class cds_static_vector {
+  static_assert(N, "cds_static_vector does not support zero capacity");
+
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Const reference to T.
+  using const_reference = const T&;
+  /// @brief cds_static_vector size type.
+  using size_type = std::size_t;
+
+  /// @brief Constructs an empty vector. No memory is allocated.
+  cds_static_vector() noexcept {
+    for (auto& state : states_) {
+      state.store(empty_slot, std::memory_order_relaxed);
+    }
+  }
+
+  cds_static_vector(const cds_static_vector&) = delete;
+  cds_static_vector& operator=(const cds_static_vector&) = delete;
+
+  /// @brief Destroys every published element.
+  ~cds_static_vector() { destroy_all_(); }
+
+  /// @brief Appends a copy of value if there is room. Lock-free.
+  /// @param value The value to append.
+  /// @return false if the vector is full.
+  bool try_push_back(const T& value) { return try_emplace_back(value); }
+
+  /// @brief Appends value by moving it if there is room. Lock-free.
+  /// @param value The value to append.
+  /// @return false if the vector is full; value is left untouched then.
+  bool try_push_back(T&& value) { return try_emplace_back(std::move(value)); }
+
+  /// @brief Constructs an element in place from args if there is room.
+  /// Lock-free. If the constructor throws, the claimed slot is skipped by
+  /// readers and the exception propagates.
+  /// @param args The arguments forwarded to T's constructor.
+  /// @return false if the vector is full.
+  template <typename... Args>
+  bool try_emplace_back(Args&&... args) {
+    // Checking first keeps a full vector's counter from creeping upwards.
+    if (claimed_.load(std::memory_order_relaxed) >= N) {
+      return false;
+    }
+    const size_type pos = claimed_.fetch_add(1, std::memory_order_relaxed);
+    if (pos >= N) {
+      return false;
+    }
+
+    try {
+      ::new (static_cast<void*>(slot_(pos))) T(std::forward<Args>(args)...);
+    } catch (...) {
+      states_[pos].store(failed_slot, std::memory_order_release);
+      throw;
+    }
+    states_[pos].store(ready_slot, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Returns whether the element at pos has been published.
+  /// @param pos The specified position.
+  /// @return true if at(pos) may be called.
+  bool is_ready(const size_type pos) const noexcept {
+    return pos < N &&
+           states_[pos].load(std::memory_order_acquire) == ready_slot;
+  }
+
+  /// @brief Returns a const_reference to a published element. Lock-free.
+  /// @param pos The specified position.
+  /// @return A const_reference to the value at position pos.
+  const_reference at(const size_type pos) const {
+    if (!is_ready(pos)) {
+      throw std::out_of_range("element not available");
+    }
+
+    return *slot_(pos);
+  }
+
+  /// @brief Returns a const_reference to a published element. Functionally
+  /// equivalent to at().
+  /// @param pos The specified position.
+  /// @return A const_reference to the value at position pos.
+  const_reference operator[](const size_type pos) const { return at(pos); }
+
+  /// @brief Calls f(pos, element) for every published element, in order of
+  /// position. Slots claimed but not yet published are skipped. Lock-free.
+  /// @param f The function to call.
+  template <typename F>
+  void for_each_ready(F&& f) const {
+    const size_type claimed = size();
+    for (size_type pos = 0; pos < claimed; ++pos) {
+      if (is_ready(pos)) {
+        f(pos, *slot_(pos));
+      }
+    }
+  }
+
+  /// @brief Returns the number of claimed slots. Some of them may still be
+  /// under construction; see is_ready().
+  /// @return The number of claimed slots, at most N.
+  size_type size() const noexcept {
+    return std::min(claimed_.load(std::memory_order_acquire), N);
+  }
+
+  /// @brief Returns whether no slot has been claimed.
+  /// @return true if empty, false otherwise.
+  bool empty() const noexcept { return size() == 0; }
+
+  /// @brief Returns whether every slot has been claimed.
+  /// @return true if further appends will fail.
+  bool full() const noexcept { return size() == N; }
+
+  /// @brief Returns the capacity. This is equivalent to template parameter N.
+  /// @return The maximum number of elements.
+  constexpr size_type capacity() const noexcept { return N; }
+
+  /// @brief Destroys every element and empties the vector.
+  /// @warning Not thread-safe: no append or read may run concurrently, for
+  /// instance between two batches.
+  void clear() noexcept {
+    destroy_all_();
+    claimed_.store(0, std::memory_order_release);
+  }
+
+ private:
+  enum : std::uint8_t { empty_slot, ready_slot, failed_slot };
+
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  std::atomic<std::uint8_t> states_[N];
+  alignas(64) std::atomic<size_type> claimed_{0};
+
+  T* slot_(const size_type pos) noexcept {
+    return std::launder(reinterpret_cast<T*>(storage_) + pos);
+  }
+  const T* slot_(const size_type pos) const noexcept {
+    return std::launder(reinterpret_cast<const T*>(storage_) + pos);
+  }
+
+  void destroy_all_() noexcept {
+    const size_type claimed = size();
+    for (size_type pos = 0; pos < claimed; ++pos) {
+      if (states_[pos].load(std::memory_order_acquire) == ready_slot) {
+        slot_(pos)->~T();
+      }
+      states_[pos].store(empty_slot, std::memory_order_relaxed);
+    }
+  }
+};
+}  // namespace cds
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cds_simd.h"
+
+namespace cds {
+
+/// @brief The default buffer size, in bytes, from which fill and copy
+/// operations bypass the cache with non-temporal stores.
+inline constexpr std::size_t default_streaming_threshold = 16 * 1024 * 1024;
+
+namespace detail {
+
+inline std::atomic<std::size_t>& streaming_threshold_storage() noexcept {
+  static std::atomic<std::size_t> threshold(default_streaming_threshold);
+  return threshold;
+}
+
+}  // namespace detail
+
+/// @brief Returns the buffer size from which fills and copies of trivially
+/// copyable elements use non-temporal stores.
+/// @return The streaming threshold in bytes.
+inline std::size_t streaming_threshold() noexcept {
+  return detail::streaming_threshold_storage().load(std::memory_order_relaxed);
+}
+
+/// @brief Sets the buffer size from which fills and copies of trivially
+/// copyable elements use non-temporal stores. Buffers this large should
+/// exceed the last-level cache, otherwise streaming only slows them down.
+/// @param bytes The new threshold in bytes; SIZE_MAX disables streaming.
+inline void set_streaming_threshold(const std::size_t bytes) noexcept {
+  detail::streaming_threshold_storage().store(bytes,
+                                              std::memory_order_relaxed);
+}
+
+namespace detail {
+
+#if CDS_SIMD_X86
+/// @brief Streams len bytes (a multiple of 16) of a repeating 16-byte
+/// pattern to 16-byte aligned dst.
+CDS_TARGET("sse2")
+inline void stream_pattern_sse2(unsigned char* dst, std::size_t len,
+                                const unsigned char* pattern) noexcept {
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+  for (; len >= 16; len -= 16, dst += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst), v);
+  }
+  _mm_sfence();
+}
+
+/// @brief Streams len bytes (a multiple of 32) of a repeating 32-byte
+/// pattern to 32-byte aligned dst.
+CDS_TARGET("avx2")
+inline void stream_pattern_avx2(unsigned char* dst, std::size_t len,
+                                const unsigned char* pattern) noexcept {
+  const __m256i v =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+  for (; len >= 32; len -= 32, dst += 32) {
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst), v);
+  }
+  _mm_sfence();
+}
+
+/// @brief Copies len bytes (a multiple of 16) to 16-byte aligned dst with
+/// non-temporal stores.
+CDS_TARGET("sse2")
+inline void stream_copy_sse2(unsigned char* dst, const unsigned char* src,
+                             std::size_t len) noexcept {
+  for (; len >= 16; len -= 16, dst += 16, src += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+  }
+  _mm_sfence();
+}
+
+/// @brief Copies len bytes (a multiple of 32) to 32-byte aligned dst with
+/// non-temporal stores.
+CDS_TARGET("avx2")
+inline void stream_copy_avx2(unsigned char* dst, const unsigned char* src,
+                             std::size_t len) noexcept {
+  for (; len >= 32; len -= 32, dst += 32, src += 32) {
+    _mm256_stream_si256(
+        reinterpret_cast<__m256i*>(dst),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+  }
+  _mm_sfence();
+}
+#endif
+
+/// @brief Returns the vector width used for streaming, or 0 if streaming is
+/// unavailable on this CPU.
+inline std::size_t streaming_width() noexcept {
+#if CDS_SIMD_X86
+  const simd_level level = active_simd_level();
+  if (level >= simd_level::avx2) {
+    return 32;
+  }
+  if (level == simd_level::sse2) {
+    return 16;
+  }
+#endif
+  return 0;
+}
+
+/// @brief Returns whether a buffer of the given size should be streamed.
+inline bool should_stream(const std::size_t bytes) noexcept {
+  return bytes && bytes >= streaming_threshold() && streaming_width() != 0;
+}
+
+/// @brief Assigns value to n elements starting at first. Large buffers of
+/// trivially copyable elements whose size divides 16 are written with
+/// non-temporal stores; everything else uses std::fill.
+/// @param first The start of the buffer. For trivially copyable types, it
+/// may point to uninitialized storage.
+/// @param n The number of elements.
+/// @param value The value to assign.
+template <typename T>
+void bulk_fill(T* first, const std::size_t n, const T& value) {
+#if CDS_SIMD_X86
+  if constexpr (std::is_trivially_copyable_v<T> && 16 % sizeof(T) == 0) {
+    const std::size_t width = streaming_width();
+    if (should_stream(n * sizeof(T)) &&
+        reinterpret_cast<std::uintptr_t>(first) % sizeof(T) == 0) {
+      // Fill element by element up to a vector boundary, which is then
+      // also an element boundary.
+      T* const last = first + n;
+      while (first != last &&
+             reinterpret_cast<std::uintptr_t>(first) % width != 0) {
+        *first++ = value;
+      }
+
+      unsigned char pattern[32];
+      for (std::size_t offset = 0; offset < 32; offset += sizeof(T)) {
+        std::memcpy(pattern + offset, &value, sizeof(T));
+      }
+
+      const std::size_t body = (last - first) * sizeof(T) / width * width;
+      unsigned char* dst = reinterpret_cast<unsigned char*>(first);
+      if (width == 32) {
+        stream_pattern_avx2(dst, body, pattern);
+      } else {
+        stream_pattern_sse2(dst, body, pattern);
+      }
+      std::fill(first + body / sizeof(T), last, value);
+      return;
+    }
+  }
+#endif
+  std::fill(first, first + n, value);
+}
+
+/// @brief Copies n elements from src to dst. Large buffers of trivially
+/// copyable elements are written with non-temporal stores; everything else
+/// uses std::copy.
+/// @param src The source buffer.
+/// @param n The number of elements.
+/// @param dst The destination buffer, which must not overlap src. For
+/// trivially copyable types, it may point to uninitialized storage.
+template <typename T>
+void bulk_copy(const T* src, const std::size_t n, T* dst) {
+#if CDS_SIMD_X86
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    const std::size_t width = streaming_width();
+    const std::size_t bytes = n * sizeof(T);
+    if (should_stream(bytes)) {
+      unsigned char* out = reinterpret_cast<unsigned char*>(dst);
+      const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+      const std::size_t head = std::min(
+          bytes, (width - reinterpret_cast<std::uintptr_t>(out) % width) %
+                     width);
+      std::memcpy(out, in, head);
+
+      const std::size_t body = (bytes - head) / width * width;
+      if (width == 32) {
+        stream_copy_avx2(out + head, in + head, body);
+      } else {
+        stream_copy_sse2(out + head, in + head, body);
+      }
+      std::memcpy(out + head + body, in + head + body, bytes - head - body);
+      return;
+    }
+  }
+#endif
+  std::copy(src, src + n, dst);
+}
+
+}  // namespace detail
+}  // namespace cds
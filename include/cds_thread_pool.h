@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cds_numa.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cds {
+
+/// @brief Options controlling how a thread_pool creates its workers.
+struct thread_pool_options {
+  /// @brief The number of workers. 0 selects
+  /// std::thread::hardware_concurrency().
+  std::size_t threads = 0;
+  /// @brief If true, each worker is pinned to a single CPU.
+  bool pin_threads = false;
+  /// @brief If true, workers are spread round-robin over NUMA nodes, kept on
+  /// their node's CPUs, and steal from workers on the same node first.
+  bool group_by_node = false;
+};
+
+namespace detail {
+
+/// @brief A move-only type-erased nullary task.
+class pool_task {
+ public:
+  pool_task() = default;
+
+  template <typename F>
+  explicit pool_task(F&& f)
+      : impl_(std::make_unique<model<std::decay_t<F>>>(std::forward<F>(f))) {}
+
+  void operator()() { impl_->run(); }
+
+ private:
+  struct concept_t {
+    virtual ~concept_t() = default;
+    virtual void run() = 0;
+  };
+
+  template <typename F>
+  struct model : concept_t {
+    explicit model(F&& f) : fn(std::move(f)) {}
+    explicit model(const F& f) : fn(f) {}
+    void run() override { fn(); }
+    F fn;
+  };
+
+  std::unique_ptr<concept_t> impl_;
+};
+
+/// @brief The shared state behind a task_future.
+template <typename R>
+struct future_state {
+  std::atomic<bool> ready{false};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::optional<std::conditional_t<std::is_void_v<R>, char, R>> value;
+  std::exception_ptr error;
+
+  void finish() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ready.store(true, std::memory_order_release);
+    }
+    cv.notify_all();
+  }
+};
+
+}  // namespace detail
+
+class thread_pool;
+
+/// @brief A lightweight future for a task submitted to a thread_pool. When
+/// waited on from one of the pool's workers, the worker keeps running other
+/// tasks instead of blocking.
+/// @tparam R The result type of the task.
+template <typename R>
+class task_future {
+ public:
+  task_future() = default;
+
+  /// @brief Returns whether the task has completed.
+  /// @return true if the result is available.
+  bool ready() const noexcept {
+    return state_ && state_->ready.load(std::memory_order_acquire);
+  }
+
+  /// @brief Blocks until the task has completed.
+  void wait() const;
+
+  /// @brief Waits for the task and returns its result, rethrowing any
+  /// exception it threw. May only be called once.
+  /// @return The result of the task.
+  R get() {
+    wait();
+    std::shared_ptr<detail::future_state<R>> state = std::move(state_);
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
+    if constexpr (!std::is_void_v<R>) {
+      return std::move(*state->value);
+    }
+  }
+
+  /// @brief Returns whether this future refers to a task.
+  /// @return true if get() may be called.
+  bool valid() const noexcept { return static_cast<bool>(state_); }
+
+ private:
+  friend class thread_pool;
+
+  task_future(std::shared_ptr<detail::future_state<R>> state,
+              thread_pool* pool)
+      : state_(std::move(state)), pool_(pool) {}
+
+  std::shared_ptr<detail::future_state<R>> state_;
+  thread_pool* pool_ = nullptr;
+};
+
+/// @brief A work-stealing thread pool. Each worker owns a deque: it pushes
+/// and pops its own tasks at the back, while idle workers steal from the
+/// front of randomly chosen victims. Idle workers sleep until work arrives.
+/// @note thread_pool provides parallel_for(), so it can be passed to the
+/// cds::parallel algorithms in place of an execution policy.
+class thread_pool {
+ public:
+  /// @brief Starts the workers.
+  /// @param options The worker count, pinning and NUMA grouping options.
+  explicit thread_pool(const thread_pool_options& options = {})
+      : options_(options) {
+    std::size_t n = options.threads ? options.threads
+                                    : std::thread::hardware_concurrency();
+    n = n ? n : 1;
+
+    const numa_topology& topology = numa_topology::instance();
+    std::vector<std::size_t> nodes;
+    for (std::size_t node = 0; node < topology.node_count(); ++node) {
+      if (!topology.cpus(node).empty()) {
+        nodes.push_back(node);
+      }
+    }
+
+    workers_.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      auto w = std::make_unique<worker>();
+      if (options.group_by_node && !nodes.empty()) {
+        // Workers of the same node are i, i + nodes.size(), ...
+        w->node = nodes[i % nodes.size()];
+        w->slot = i / nodes.size();
+      } else {
+        w->slot = i;
+      }
+      workers_.push_back(std::move(w));
+    }
+
+    try {
+      for (std::size_t i = 0; i < n; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { run_worker(i); });
+        place(i);
+      }
+    } catch (...) {
+      shutdown();
+      throw;
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /// @brief Runs every queued task to completion and joins the workers.
+  ~thread_pool() { shutdown(); }
+
+  /// @brief Returns the number of workers.
+  /// @return The worker count.
+  std::size_t size() const noexcept { return workers_.size(); }
+
+  /// @brief Queues f for execution. Tasks submitted from a worker go to that
+  /// worker's own deque; others are distributed round-robin.
+  /// @param f The nullary function to run.
+  /// @return A future for the result of f.
+  template <typename F>
+  auto submit(F&& f) -> task_future<std::invoke_result_t<std::decay_t<F>>> {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto state = std::make_shared<detail::future_state<R>>();
+    push(detail::pool_task(
+        [state, fn = std::forward<F>(f)]() mutable {
+          try {
+            if constexpr (std::is_void_v<R>) {
+              fn();
+              state->value.emplace();
+            } else {
+              state->value.emplace(fn());
+            }
+          } catch (...) {
+            state->error = std::current_exception();
+          }
+          state->finish();
+        }));
+    return task_future<R>(std::move(state), this);
+  }
+
+  /// @brief Splits [first, last) into chunks of grain indices and calls
+  /// f(chunk_first, chunk_last) for each, on the workers and the calling
+  /// thread. Chunks are handed out dynamically, so uneven chunks balance
+  /// out. Returns once every chunk has completed; the first exception thrown
+  /// by f is rethrown.
+  /// @tparam F Callable with signature void(std::size_t, std::size_t).
+  /// @param first The first index of the range.
+  /// @param last One past the last index of the range.
+  /// @param grain The chunk size; 0 picks about four chunks per worker.
+  /// @param f The function to call for each chunk.
+  template <typename F>
+  void parallel_for(const std::size_t first, const std::size_t last,
+                    std::size_t grain, F&& f) {
+    if (first >= last) {
+      return;
+    }
+
+    const std::size_t n = last - first;
+    if (!grain) {
+      grain = std::max<std::size_t>(1, n / (4 * size()));
+    }
+    const std::size_t chunks = (n + grain - 1) / grain;
+    if (chunks == 1) {
+      f(first, last);
+      return;
+    }
+
+    struct loop_state {
+      std::atomic<std::size_t> next{0};
+      std::atomic<std::size_t> done{0};
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::exception_ptr error;
+    };
+    auto state = std::make_shared<loop_state>();
+    auto* fn = &f;
+
+    // Late helpers find no chunks left and never touch fn.
+    auto work = [state, fn, first, last, grain, chunks]() {
+      std::size_t chunk;
+      while ((chunk = state->next.fetch_add(1)) < chunks) {
+        const std::size_t b = first + chunk * grain;
+        try {
+          (*fn)(b, std::min(b + grain, last));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (!state->error) {
+            state->error = std::current_exception();
+          }
+        }
+        if (state->done.fetch_add(1) + 1 == chunks) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->cv.notify_all();
+        }
+      }
+    };
+
+    const std::size_t helpers = std::min(size(), chunks - 1);
+    for (std::size_t i = 0; i < helpers; ++i) {
+      push(detail::pool_task(work));
+    }
+    work();
+
+    auto finished = [&state, chunks]() { return state->done == chunks; };
+    if (current_worker_ && current_pool_ == this) {
+      while (!finished()) {
+        if (!run_one(*current_worker_)) {
+          std::this_thread::yield();
+        }
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->cv.wait(lock, finished);
+    }
+
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
+  }
+
+ private:
+  template <typename R>
+  friend class task_future;
+
+  struct alignas(64) worker {
+    std::mutex mutex;
+    std::deque<detail::pool_task> tasks;
+    std::size_t node = 0;
+    // The worker's position among the workers sharing its node, or among
+    // all workers when they are not grouped; picks the CPU it is pinned to.
+    std::size_t slot = 0;
+    std::thread thread;
+  };
+
+  static inline thread_local thread_pool* current_pool_ = nullptr;
+  static inline thread_local std::size_t* current_worker_ = nullptr;
+
+  thread_pool_options options_;
+  std::vector<std::unique_ptr<worker>> workers_;
+  std::atomic<std::size_t> next_worker_{0};
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> idle_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& w : workers_) {
+      if (w->thread.joinable()) {
+        w->thread.join();
+      }
+    }
+  }
+
+  void place(const std::size_t index) {
+#if defined(__linux__)
+    if (!options_.pin_threads && !options_.group_by_node) {
+      return;
+    }
+
+    const numa_topology& topology = numa_topology::instance();
+    const std::vector<unsigned>& node_cpus = topology.cpus(workers_[index]->node);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (options_.pin_threads) {
+      if (options_.group_by_node && !node_cpus.empty()) {
+        CPU_SET(node_cpus[workers_[index]->slot % node_cpus.size()], &set);
+      } else {
+        // CPU ids need not be contiguous, and the cpuset may exclude some.
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+          return;
+        }
+        const int count = CPU_COUNT(&allowed);
+        if (count == 0) {
+          return;
+        }
+        int target = static_cast<int>(workers_[index]->slot % count);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+          if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            CPU_SET(cpu, &set);
+            break;
+          }
+        }
+      }
+    } else {
+      for (const unsigned cpu : node_cpus) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    // Best effort; restricted cpusets simply keep the default affinity.
+    pthread_setaffinity_np(workers_[index]->thread.native_handle(),
+                           sizeof(set), &set);
+#else
+    (void)index;
+#endif
+  }
+
+  void push(detail::pool_task task) {
+    const std::size_t index = current_pool_ == this
+                                  ? *current_worker_
+                                  : next_worker_.fetch_add(1) % size();
+    // Count the task before publishing it so pending_ never underflows.
+    pending_.fetch_add(1);
+    try {
+      worker& w = *workers_[index];
+      std::lock_guard<std::mutex> lock(w.mutex);
+      w.tasks.push_back(std::move(task));
+    } catch (...) {
+      pending_.fetch_sub(1);
+      throw;
+    }
+
+    if (idle_.load() > 0) {
+      { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+      sleep_cv_.notify_one();
+    }
+  }
+
+  bool pop_local(const std::size_t index, detail::pool_task& task) {
+    worker& w = *workers_[index];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty()) {
+      return false;
+    }
+    task = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    return true;
+  }
+
+  bool steal(const std::size_t thief, detail::pool_task& task) {
+    thread_local std::uint64_t seed =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    const std::size_t n = size();
+    const std::size_t start = seed % n;
+    // With NUMA grouping, a first pass only considers same-node victims.
+    for (int pass = options_.group_by_node ? 0 : 1; pass < 2; ++pass) {
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t victim = (start + i) % n;
+        if (victim == thief ||
+            (pass == 0 && workers_[victim]->node != workers_[thief]->node)) {
+          continue;
+        }
+
+        worker& w = *workers_[victim];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (!w.tasks.empty()) {
+          task = std::move(w.tasks.front());
+          w.tasks.pop_front();
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  bool run_one(const std::size_t index) {
+    detail::pool_task task;
+    if (!pop_local(index, task) && !steal(index, task)) {
+      return false;
+    }
+
+    pending_.fetch_sub(1);
+    task();
+    return true;
+  }
+
+  void run_worker(std::size_t index) {
+    current_pool_ = this;
+    current_worker_ = &index;
+
+    for (;;) {
+      if (run_one(index)) {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      idle_.fetch_add(1);
+      sleep_cv_.wait(lock, [this]() { return stop_ || pending_.load() > 0; });
+      idle_.fetch_sub(1);
+      if (stop_ && pending_.load() == 0) {
+        break;
+      }
+    }
+
+    current_pool_ = nullptr;
+    current_worker_ = nullptr;
+  }
+};
+
+template <typename R>
+void task_future<R>::wait() const {
+  if (ready()) {
+    return;
+  }
+
+  if (pool_ && thread_pool::current_pool_ == pool_) {
+    while (!ready()) {
+      if (!pool_->run_one(*thread_pool::current_worker_)) {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->cv.wait(lock, [this]() { return ready(); });
+}
+}  // namespace cds
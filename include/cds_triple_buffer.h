@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace cds {
+
+/// @brief A wait-free, single-producer/single-consumer channel that always
+/// hands the reader the latest complete value. The writer owns a back slot,
+/// the reader owns a front slot, and a third slot sits in the middle; both
+/// publish() and update() are a single atomic exchange of slot indices, so
+/// neither side ever blocks, and no value is copied between slots.
+/// @tparam T The payload type, e.g. a std::array for fixed-size frames.
+/// @note Exactly one thread may use the writer interface (write_buffer,
+/// publish, write) and exactly one thread the reader interface (update,
+/// read, read_latest, has_update) at a time.
+template <typename T>
+class triple_buffer {
+ public:
+  /// @brief Template parameter T.
+  using value_type = T;
+  /// @brief Reference to T.
+  using reference = T&;
+  /// @brief Const reference to T.
+  using const_reference = const T&;
+
+  /// @brief Constructs a triple_buffer with value-initialized slots.
+  triple_buffer() : slots_{} {}
+
+  /// @brief Constructs a triple_buffer with every slot set to value, which
+  /// the reader sees until the first publish.
+  /// @param value The initial value.
+  explicit triple_buffer(const T& value) : slots_{{value}, {value}, {value}} {}
+
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+
+  /// @brief Returns the writer's back slot. Its contents are whatever was
+  /// last left there, not necessarily the latest published value.
+  /// @return A reference to the back slot.
+  reference write_buffer() noexcept { return slots_[back_].value; }
+
+  /// @brief Publishes the back slot to the reader and takes a new back slot.
+  /// Never blocks.
+  void publish() noexcept {
+    const std::uint8_t previous =
+        middle_.exchange(back_ | dirty_bit, std::memory_order_acq_rel);
+    back_ = previous & index_mask;
+  }
+
+  /// @brief Assigns value to the back slot and publishes it.
+  /// @param value The value to publish.
+  template <typename U>
+  void write(U&& value) {
+    write_buffer() = std::forward<U>(value);
+    publish();
+  }
+
+  /// @brief Returns whether a value was published since the reader last
+  /// called update().
+  /// @return true if update() would pick up a new value.
+  bool has_update() const noexcept {
+    return middle_.load(std::memory_order_relaxed) & dirty_bit;
+  }
+
+  /// @brief Swaps the freshest published value into the reader's front
+  /// slot, if there is one. Never blocks.
+  /// @return true if the front slot now holds a newer value.
+  bool update() noexcept {
+    if (!has_update()) {
+      return false;
+    }
+
+    const std::uint8_t previous =
+        middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = previous & index_mask;
+    return true;
+  }
+
+  /// @brief Returns the reader's front slot, which stays stable until the
+  /// next update().
+  /// @return A const_reference to the front slot.
+  const_reference read() const noexcept { return slots_[front_].value; }
+
+  /// @brief Calls update() and returns the front slot.
+  /// @return A const_reference to the latest published value.
+  const_reference read_latest() noexcept {
+    update();
+    return read();
+  }
+
+ private:
+  static constexpr std::uint8_t index_mask = 0x3;
+  static constexpr std::uint8_t dirty_bit = 0x4;
+
+  struct alignas(64) slot {
+    T value;
+  };
+
+  slot slots_[3];
+  alignas(64) std::uint8_t back_ = 0;
+  alignas(64) std::atomic<std::uint8_t> middle_{1};
+  alignas(64) std::uint8_t front_ = 2;
+};
+}  // namespace cds
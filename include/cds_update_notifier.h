@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "cds_simd.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <climits>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace cds {
+
+/// @brief A version counter that threads can block on until it changes.
+/// Waiters spin briefly, then park in the kernel (a futex on Linux, a
+/// condition variable elsewhere). notify() only makes a system call when a
+/// waiter is actually parked, so writers with no waiters pay a single atomic
+/// increment. Writers that stamp data with the version can split notify()
+/// into advance(), under their own lock, and wake(), after releasing it.
+class update_notifier {
+ public:
+  /// @brief The version counter type.
+  using version_type = std::uint64_t;
+
+  /// @brief The number of times a waiter polls before parking.
+  static constexpr int spin_limit = 128;
+
+  update_notifier() = default;
+  update_notifier(const update_notifier&) = delete;
+  update_notifier& operator=(const update_notifier&) = delete;
+
+  /// @brief Returns the current version.
+  /// @return The number of advance() and notify() calls so far.
+  version_type version() const noexcept {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Advances the version and wakes every waiter, if there are any.
+  void notify() noexcept {
+    advance();
+    wake();
+  }
+
+  /// @brief Advances the version without waking anyone. Must be followed by
+  /// wake() for waiters to notice.
+  /// @return The new version.
+  version_type advance() noexcept {
+    return version_.fetch_add(1, std::memory_order_seq_cst) + 1;
+  }
+
+  /// @brief Wakes every waiter, if there are any, after advance().
+  void wake() noexcept {
+    // Pairs with the waiter registering before its final version check: one
+    // of the two sides is guaranteed to see the other's advance.
+    if (waiters_.load(std::memory_order_seq_cst) == 0) {
+      return;
+    }
+#if defined(__linux__)
+    syscall(SYS_futex, futex_word(), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr,
+            nullptr, 0);
+#else
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cv_.notify_all();
+#endif
+  }
+
+  /// @brief Blocks until the version differs from last_seen.
+  /// @param last_seen The version the caller has already observed.
+  /// @return The new version.
+  version_type wait(const version_type last_seen) const noexcept {
+    return wait_until_(last_seen, nullptr);
+  }
+
+  /// @brief Blocks until the version differs from last_seen or timeout
+  /// elapses, whichever comes first.
+  /// @param last_seen The version the caller has already observed.
+  /// @param timeout The maximum time to wait.
+  /// @return The current version, which equals last_seen on timeout.
+  template <typename Rep, typename Period>
+  version_type wait_for(
+      const version_type last_seen,
+      const std::chrono::duration<Rep, Period>& timeout) const noexcept {
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            timeout);
+    return wait_until_(last_seen, &deadline);
+  }
+
+ private:
+  std::atomic<version_type> version_{0};
+  mutable std::atomic<std::uint32_t> waiters_{0};
+#if !defined(__linux__)
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cv_;
+#endif
+
+#if defined(__linux__)
+  // The futex is the low 32 bits of the version. A waiter could only miss
+  // a change of exactly a multiple of 2^32 between its check and its wait.
+  std::uint32_t* futex_word() const noexcept {
+    static_assert(sizeof(version_) == sizeof(version_type),
+                  "version must be a plain 64-bit word");
+    auto* halves = reinterpret_cast<std::uint32_t*>(
+        const_cast<std::atomic<version_type>*>(&version_));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return halves + 1;
+#else
+    return halves;
+#endif
+  }
+#endif
+
+  version_type wait_until_(
+      const version_type last_seen,
+      const std::chrono::steady_clock::time_point* deadline) const noexcept {
+    version_type current = version();
+    for (int spin = 0; current == last_seen && spin < spin_limit; ++spin) {
+#if CDS_SIMD_X86
+      _mm_pause();
+#endif
+      current = version();
+    }
+    if (current != last_seen) {
+      return current;
+    }
+
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+#if defined(__linux__)
+    while ((current = version_.load(std::memory_order_seq_cst)) ==
+           last_seen) {
+      timespec relative{};
+      timespec* timeout = nullptr;
+      if (deadline) {
+        const auto remaining =
+            *deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+          break;
+        }
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)
+                .count();
+        relative.tv_sec = static_cast<time_t>(ns / 1000000000);
+        relative.tv_nsec = static_cast<long>(ns % 1000000000);
+        timeout = &relative;
+      }
+      // Returns immediately if the version has already moved on.
+      syscall(SYS_futex, futex_word(), FUTEX_WAIT_PRIVATE,
+              static_cast<std::uint32_t>(last_seen), timeout, nullptr, 0);
+    }
+#else
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto changed = [&] {
+        current = version_.load(std::memory_order_seq_cst);
+        return current != last_seen;
+      };
+      if (deadline) {
+        cv_.wait_until(lock, *deadline, changed);
+      } else {
+        cv_.wait(lock, changed);
+      }
+    }
+#endif
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return current;
+  }
+};
+}  // namespace cds
@@ -1,22 +1,35 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "cds_serialize.h"
+#include "cds_streaming.h"
+#include "cds_update_notifier.h"
+
 namespace cds {
 
 /// @brief A thread-safe dynamic array inspired by std::vector.
 /// @tparam T The type of object the vector will hold.
 /// @tparam Allocator The allocator used to acquire/release memory, and
 /// construct/destroy elements.
-template <typename T, typename Allocator = std::allocator<T>>
+/// @tparam Mutex The SharedMutex guarding the elements, e.g.
+/// std::shared_mutex or cds::bravo_shared_mutex for read-mostly use.
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Mutex = std::shared_mutex>
 class cds_vector {
  public:
   /// @brief Template parameter T.
@@ -44,6 +57,315 @@ class cds_vector {
   using size_type = std::size_t;
   /// @brief cds_vector difference type.
   using difference_type = std::ptrdiff_t;
+  /// @brief Template parameter Mutex.
+  using mutex_type = Mutex;
+
+  /// @brief A convenience struct which acquires a write lock for the target
+  /// vector and exposes an interface for batch writes. Unlike cds_vector,
+  /// these functions do not acquire a lock at each write. Waiters in
+  /// wait_for_update() are notified once the scope ends.
+  /// @warning This interface exposes non-const references, which can be used
+  /// outside the scope of the lock.
+  struct scoped_write {
+    /// @brief Construct a new scoped_write.
+    /// @param vec The input cds_vector to build the scoped_write object for.
+    explicit scoped_write(cds_vector& vec) : vector_(vec), lock_(vec.mutex_) {}
+    scoped_write(const scoped_write&) = delete;
+    scoped_write& operator=(const scoped_write&) = delete;
+    scoped_write(scoped_write&&) = default;
+    scoped_write& operator=(scoped_write&&) = default;
+
+    /// @brief Releases the write lock, then notifies update waiters.
+    ~scoped_write() {
+      if (lock_.owns_lock()) {
+        lock_.unlock();
+        vector_.notifier_.notify();
+      }
+    }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference at(const size_type pos) {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.start_[pos];
+    }
+
+    /// @brief Returns a reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A reference to the value at position pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+    /// @brief Returns a reference to the value at the front of the vector.
+    /// @return A reference to the value at the front of the vector.
+    reference front() { return at(0); }
+
+    /// @brief Returns a reference to the value at the back of the vector.
+    /// @return A reference to the value at the back of the vector.
+    reference back() { return at(size() - 1); }
+
+    /// @brief Returns an iterator pointing to the start of the vector, valid
+    /// until the scope ends or the vector reallocates.
+    /// @return An iterator pointing to the start of the vector.
+    iterator begin() noexcept { return vector_.start_; }
+
+    /// @brief Returns an iterator pointing to the end of the vector, valid
+    /// until the scope ends or the vector reallocates.
+    /// @return An iterator pointing to the end of the vector.
+    iterator end() noexcept { return vector_.start_ + size(); }
+
+    /// @brief Appends value to the end of the vector, reallocating if the
+    /// capacity is exhausted. References obtained earlier may be invalidated.
+    /// @param value The value to append.
+    void push_back(const_reference value) {
+      vector_.emplace_back_unlocked_(value);
+    }
+
+    /// @brief Appends value to the end of the vector by moving it.
+    /// @param value The value to append.
+    void push_back(T&& value) {
+      vector_.emplace_back_unlocked_(std::move(value));
+    }
+
+    /// @brief Removes the element at the specified position, shifting later
+    /// elements down by one.
+    /// @param pos The position of the element to remove.
+    void erase(const size_type pos) { vector_.erase_unlocked_(pos); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_vector& vector_;
+    std::unique_lock<Mutex> lock_;
+  };
+
+  /// @brief A convenience struct which acquires a read lock for the target
+  /// vector and exposes an interface for batch reads. Unlike cds_vector, these
+  /// functions do not acquire a lock at each read.
+  struct scoped_read {
+    /// @brief Construct a new scoped_read.
+    /// @param vec The input cds_vector to build the scoped_read object for.
+    explicit scoped_read(cds_vector& vec) : vector_(vec), lock_(vec.mutex_) {}
+    scoped_read(const scoped_read&) = delete;
+    scoped_read& operator=(const scoped_read&) = delete;
+    scoped_read(scoped_read&&) = default;
+    scoped_read& operator=(scoped_read&&) = default;
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to operator[].
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference at(const size_type pos) const {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return vector_.start_[pos];
+    }
+
+    /// @brief Returns a const_reference to the value at the specified position.
+    /// Functionally equivalent to at().
+    /// @param pos The specified position.
+    /// @return A const_reference to the value at position pos.
+    const_reference operator[](const size_type pos) const { return at(pos); }
+
+    /// @brief Returns a const_reference to the value at the front of the
+    /// vector.
+    /// @return A const_reference to the value at the front of the vector.
+    const_reference front() const { return at(0); }
+
+    /// @brief Returns a const_reference to the value at the back of the vector.
+    /// @return A const_reference to the value at the back of the vector.
+    const_reference back() const { return at(size() - 1); }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    cds_vector& vector_;
+    std::shared_lock<Mutex> lock_;
+  };
+
+  class range_session;
+
+  /// @brief Exclusive write access to the elements [first, last) of a vector
+  /// held by a range_session. Obtained from range_session::lock_range() and
+  /// released when it goes out of scope. Positions are relative to first.
+  class scoped_range {
+   public:
+    scoped_range(const scoped_range&) = delete;
+    scoped_range& operator=(const scoped_range&) = delete;
+    scoped_range(scoped_range&& other) noexcept
+        : session_(std::exchange(other.session_, nullptr)),
+          first_(other.first_),
+          last_(other.last_) {}
+    scoped_range& operator=(scoped_range&&) = delete;
+
+    /// @brief Releases the range, waking any lock_range() call waiting on
+    /// it.
+    ~scoped_range() {
+      if (session_) {
+        session_->release_(first_, last_);
+      }
+    }
+
+    /// @brief Returns a reference to the value at offset pos in the range.
+    /// Functionally equivalent to operator[].
+    /// @param pos The offset from the start of the range.
+    /// @return A reference to the value at position first() + pos.
+    reference at(const size_type pos) {
+      if (pos >= size()) {
+        throw std::out_of_range("element access out of range");
+      }
+
+      return session_->vector_.start_[first_ + pos];
+    }
+
+    /// @brief Returns a reference to the value at offset pos in the range.
+    /// Functionally equivalent to at().
+    /// @param pos The offset from the start of the range.
+    /// @return A reference to the value at position first() + pos.
+    reference operator[](const size_type pos) { return at(pos); }
+
+    /// @brief Returns an iterator pointing to the first element of the range,
+    /// valid until the range is released.
+    /// @return An iterator pointing to position first().
+    iterator begin() { return session_->vector_.start_ + first_; }
+
+    /// @brief Returns an iterator pointing one past the last element of the
+    /// range, valid until the range is released.
+    /// @return An iterator pointing to position first() + size().
+    iterator end() { return session_->vector_.start_ + last_; }
+
+    /// @brief Returns the position of the first element in the range.
+    /// @return The start of the range.
+    size_type first() const noexcept { return first_; }
+
+    /// @brief Returns the number of elements in the range.
+    /// @return last - first.
+    size_type size() const noexcept { return last_ - first_; }
+
+   private:
+    friend class range_session;
+
+    scoped_range(range_session& session, const size_type first,
+                 const size_type last) noexcept
+        : session_(&session), first_(first), last_(last) {}
+
+    range_session* session_;
+    size_type first_;
+    size_type last_;
+  };
+
+  /// @brief Holds the vector's write lock on behalf of a group of writers
+  /// that each fill their own slice. Any thread may call lock_range() on the
+  /// session; ranges that do not overlap are held at the same time, and
+  /// overlapping requests wait. The vector's size and buffer cannot change
+  /// while the session exists. Waiters in wait_for_update() are notified once
+  /// the session ends.
+  /// @warning Every scoped_range must be released before the session is
+  /// destroyed, and the session must be destroyed by the thread that created
+  /// it.
+  class range_session {
+   public:
+    /// @brief Construct a new range_session.
+    /// @param vec The input cds_vector to build the range_session for.
+    explicit range_session(cds_vector& vec)
+        : vector_(vec), lock_(vec.mutex_) {}
+    range_session(const range_session&) = delete;
+    range_session& operator=(const range_session&) = delete;
+
+    /// @brief Releases the write lock, then notifies update waiters.
+    ~range_session() {
+      // A scoped_range that outlives its session would dangle.
+      assert(ranges_.empty());
+      lock_.unlock();
+      vector_.notifier_.notify();
+    }
+
+    /// @brief Blocks until no held range overlaps [first, last), then claims
+    /// it.
+    /// @param first The position of the first element in the range.
+    /// @param last The position one past the last element in the range.
+    /// @return A scoped_range giving exclusive access to [first, last).
+    scoped_range lock_range(const size_type first, const size_type last) {
+      check_range_(first, last);
+      std::unique_lock<std::mutex> lock(ranges_mutex_);
+      released_.wait(lock, [&] { return !overlaps_unlocked_(first, last); });
+      claim_unlocked_(first, last);
+      return scoped_range(*this, first, last);
+    }
+
+    /// @brief Claims [first, last) if no held range overlaps it.
+    /// @param first The position of the first element in the range.
+    /// @param last The position one past the last element in the range.
+    /// @return The claimed range, or std::nullopt if it is contended.
+    std::optional<scoped_range> try_lock_range(const size_type first,
+                                               const size_type last) {
+      check_range_(first, last);
+      std::lock_guard<std::mutex> lock(ranges_mutex_);
+      if (overlaps_unlocked_(first, last)) {
+        return std::nullopt;
+      }
+      claim_unlocked_(first, last);
+      return scoped_range(*this, first, last);
+    }
+
+    /// @brief Returns the number of elements in the vector.
+    /// @return The number of elements in the vector.
+    size_type size() const noexcept { return vector_.size_unlocked_(); }
+
+   private:
+    friend class scoped_range;
+
+    cds_vector& vector_;
+    std::unique_lock<Mutex> lock_;
+    // Held ranges keyed by first element. They never overlap, so ordering by
+    // first also orders them by last.
+    std::mutex ranges_mutex_;
+    std::condition_variable released_;
+    std::map<size_type, size_type> ranges_;
+
+    void check_range_(const size_type first, const size_type last) const {
+      if (first > last || last > size()) {
+        throw std::out_of_range("element range out of range");
+      }
+    }
+
+    bool overlaps_unlocked_(const size_type first,
+                            const size_type last) const {
+      if (first == last) {
+        return false;
+      }
+      auto it = ranges_.lower_bound(last);
+      return it != ranges_.begin() && (--it)->second > first;
+    }
+
+    void claim_unlocked_(const size_type first, const size_type last) {
+      if (first != last) {
+        ranges_.emplace(first, last);
+      }
+    }
+
+    void release_(const size_type first, const size_type last) {
+      if (first == last) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(ranges_mutex_);
+        ranges_.erase(first);
+      }
+      released_.notify_all();
+    }
+  };
 
   /// @brief Constructs an empty cds_vector with a default allocator.
   cds_vector() noexcept(noexcept(Allocator()))
@@ -61,7 +383,8 @@ class cds_vector {
         allocator_(alloc) {}
 
   /// @brief Constructs a cds_vector with count copies of elements with the
-  /// given value.
+  /// given value. Buffers larger than streaming_threshold() are filled with
+  /// non-temporal stores.
   /// @param count The number of elements to allocate.
   /// @param value The value to set each element to.
   /// @param alloc The allocator to use for all memory allocations.
@@ -72,7 +395,13 @@ class cds_vector {
     end_ = start_ + count;
     end_of_storage_ = end_;
     try {
-      std::fill(start_, end_, value);
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        if (count) {
+          detail::bulk_fill(std::addressof(*start_), count, value);
+        }
+      } else {
+        std::uninitialized_fill(start_, end_, value);
+      }
     } catch (...) {
       std::allocator_traits<Allocator>::deallocate(allocator_, start_, count);
       throw;
@@ -121,18 +450,28 @@ class cds_vector {
     }
   }
 
-  /// @brief Copy constructor. Locks & copies the contents of other.
+  /// @brief Copy constructor. Locks & copies the contents of other. Buffers
+  /// larger than streaming_threshold() are copied with non-temporal stores.
   /// @param other The source cds_vector to copy from.
   cds_vector(const cds_vector& other)
       : allocator_(
             std::allocator_traits<allocator_type>::
                 select_on_container_copy_construction(other.allocator_)) {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    std::lock_guard<Mutex> lock(other.mutex_);
     const size_type size = std::distance(other.start_, other.end_of_storage_);
     start_ = std::allocator_traits<Allocator>::allocate(allocator_, size);
     end_of_storage_ = start_ + size;
     try {
-      end_ = std::uninitialized_copy(other.start_, other.end_, start_);
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        const size_type count = other.end_ - other.start_;
+        if (count) {
+          detail::bulk_copy(std::addressof(*other.start_), count,
+                            std::addressof(*start_));
+        }
+        end_ = start_ + count;
+      } else {
+        end_ = std::uninitialized_copy(other.start_, other.end_, start_);
+      }
     } catch (...) {
       std::allocator_traits<Allocator>::deallocate(allocator_, start_, size);
       throw;
@@ -144,9 +483,9 @@ class cds_vector {
   /// @param alloc The allocator to use for all memory allocations.
   cds_vector(const cds_vector& other, const Allocator& alloc)
       : allocator_(alloc) {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    std::lock_guard<Mutex> lock(other.mutex_);
     const size_type size = std::distance(other.start_, other.end_of_storage_);
-    std::allocator_traits<Allocator>::allocate(allocator_, size);
+    start_ = std::allocator_traits<Allocator>::allocate(allocator_, size);
     end_of_storage_ = start_ + size;
     try {
       end_ = std::uninitialized_copy(other.start_, other.end_, start_);
@@ -160,7 +499,7 @@ class cds_vector {
   /// of other.
   /// @param other The source cds_vector to move.
   cds_vector(cds_vector&& other) noexcept {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    std::lock_guard<Mutex> lock(other.mutex_);
     allocator_(std::move(other.allocator_));
     start_(std::exchange(other.start_, nullptr));
     end_(std::exchange(other.end_, nullptr));
@@ -174,7 +513,7 @@ class cds_vector {
   /// @param other The source cds_vector to move.
   /// @param alloc The allocator to use for all memory allocations.
   cds_vector(cds_vector&& other, const Allocator& alloc) : allocator_(alloc) {
-    std::lock_guard<std::shared_mutex> lock(other.mutex_);
+    std::lock_guard<Mutex> lock(other.mutex_);
     if (allocator_ == other.allocator_) {
       start_ = std::exchange(other.start_, nullptr);
       end_ = std::exchange(other.end_, nullptr);
@@ -227,6 +566,22 @@ class cds_vector {
   cds_vector& operator=(cds_vector&& other);
   cds_vector& operator=(std::initializer_list<T> ilist);
 
+  /// @brief Returns a new scoped_write from this vector for batch write
+  /// operations.
+  /// @return A new scoped_write instance for batch write operations.
+  scoped_write new_scoped_write() { return scoped_write(*this); }
+
+  /// @brief Returns a new scoped_read from this vector for batch read
+  /// operations.
+  /// @return A new scoped_read instance for batch read operations.
+  scoped_read new_scoped_read() { return scoped_read(*this); }
+
+  /// @brief Acquires the write lock and returns a range_session through which
+  /// several threads can write disjoint ranges of the vector in parallel.
+  /// @return A new range_session. It is not movable, so bind the result
+  /// directly: `auto session = v.new_range_session();`.
+  range_session new_range_session() { return range_session(*this); }
+
   iterator begin() { return start_; }
   iterator end() { return end_; }
   reverse_iterator rbegin() { return reverse_iterator(end()); }
@@ -238,42 +593,255 @@ class cds_vector {
   const_reverse_iterator crend() { return const_reverse_iterator(begin()); }
 
   const_reference operator[](const size_type pos) {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<Mutex> lock(mutex_);
     return *(start_ + pos);
   }
 
+  /// @brief Acquires a write lock and appends value to the end of the vector,
+  /// doubling the capacity if it is exhausted.
+  /// @param value The value to append.
+  void push_back(const_reference value) {
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      emplace_back_unlocked_(value);
+    }
+    notifier_.notify();
+  }
+
+  /// @brief Acquires a write lock and appends value to the end of the vector
+  /// by moving it, doubling the capacity if it is exhausted.
+  /// @param value The value to append.
+  void push_back(T&& value) {
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      emplace_back_unlocked_(std::move(value));
+    }
+    notifier_.notify();
+  }
+
+  /// @brief Acquires a write lock and sets the value at position pos to value.
+  /// @param pos The position in the vector to update.
+  /// @param value The value to update position pos to.
+  void set(const size_type pos, const_reference value) {
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      if (pos >= size_unlocked_()) {
+        throw std::out_of_range("element access out of range");
+      }
+      start_[pos] = value;
+    }
+    notifier_.notify();
+  }
+
+  /// @brief Acquires a write lock and removes the element at position pos,
+  /// shifting later elements down by one.
+  /// @param pos The position of the element to remove.
+  void erase(const size_type pos) {
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      erase_unlocked_(pos);
+    }
+    notifier_.notify();
+  }
+
+  /// @brief Acquires a write lock and grows the capacity to at least
+  /// new_cap elements. Does nothing if the capacity is already large enough.
+  /// @param new_cap The minimum capacity.
+  void reserve(const size_type new_cap) {
+    std::lock_guard<Mutex> lock(mutex_);
+    if (new_cap > capacity_unlocked_()) {
+      reallocate_unlocked_(new_cap);
+    }
+  }
+
   /// @brief Checks if the container is empty.
   /// @return true if empty, false otherwise.
   bool empty() const noexcept {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<Mutex> lock(mutex_);
     return empty_unlocked_();
   }
 
   /// @brief Returns the number of elements in the container.
   /// @return The number of elements in the container.
   size_type size() const noexcept {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<Mutex> lock(mutex_);
     return size_unlocked_();
   }
 
   /// @brief Returns the total reserved capacity of the container.
   /// @return The reserved capacity of the container.
   size_type capacity() const noexcept {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<Mutex> lock(mutex_);
     return capacity_unlocked_();
   }
 
+  /// @brief Returns the version, which advances once per completed
+  /// modification. Use it as the starting point for wait_for_update().
+  /// @return The current version.
+  update_notifier::version_type version() const noexcept {
+    return notifier_.version();
+  }
+
+  /// @brief Blocks until the vector is modified after version last_seen. The
+  /// caller spins briefly and then parks without holding any lock; writers
+  /// only make a wake-up call when a caller is parked.
+  /// @param last_seen The version the caller has already observed.
+  /// @return The new version.
+  update_notifier::version_type wait_for_update(
+      const update_notifier::version_type last_seen) const noexcept {
+    return notifier_.wait(last_seen);
+  }
+
+  /// @brief Blocks until the vector is modified after version last_seen, or
+  /// timeout elapses.
+  /// @param last_seen The version the caller has already observed.
+  /// @param timeout The maximum time to wait.
+  /// @return The current version, which equals last_seen on timeout.
+  template <typename Rep, typename Period>
+  update_notifier::version_type wait_for_update(
+      const update_notifier::version_type last_seen,
+      const std::chrono::duration<Rep, Period>& timeout) const noexcept {
+    return notifier_.wait_for(last_seen, timeout);
+  }
+
+  /// @brief Acquires a read lock once and passes a serial_header plus the raw
+  /// element buffer to writer in a single call, without copying either.
+  /// @tparam Writer Callable as writer(const io_slice*, std::size_t), e.g.
+  /// cds::fd_writer.
+  /// @param writer The destination of the serialized bytes.
+  template <typename Writer>
+  void serialize(Writer&& writer) const {
+    std::shared_lock<Mutex> lock(mutex_);
+    detail::write_serialized(writer, data_unlocked_(), size_unlocked_());
+  }
+
+  /// @brief Acquires a read lock once and passes a serial_header, then the
+  /// raw element buffer in slices of at most chunk_bytes, to writer. Each
+  /// slice points into the vector, so even a huge vector is never copied
+  /// into an intermediate buffer.
+  /// @tparam Writer Callable as writer(const io_slice*, std::size_t).
+  /// @param writer The destination of the serialized bytes.
+  /// @param chunk_bytes The maximum slice size.
+  template <typename Writer>
+  void serialize_chunks(Writer&& writer,
+                        const std::size_t chunk_bytes = default_serial_chunk)
+      const {
+    std::shared_lock<Mutex> lock(mutex_);
+    detail::write_serialized_chunks(writer, data_unlocked_(),
+                                    size_unlocked_(), chunk_bytes);
+  }
+
+  /// @brief Reads data produced by serialize() or serialize_chunks() into a
+  /// new buffer, then acquires a write lock only to swap it in.
+  /// @tparam Reader Callable as reader(void* dst, std::size_t bytes), filling
+  /// dst completely or throwing, e.g. cds::fd_reader.
+  /// @param reader The source of the serialized bytes.
+  template <typename Reader>
+  void deserialize(Reader&& reader) {
+    const size_type count = detail::read_serial_header<T>(reader);
+    pointer start =
+        std::allocator_traits<Allocator>::allocate(allocator_, count);
+    try {
+      if (count) {
+        reader(static_cast<void*>(std::addressof(*start)), count * sizeof(T));
+      }
+    } catch (...) {
+      std::allocator_traits<Allocator>::deallocate(allocator_, start, count);
+      throw;
+    }
+
+    pointer old_start;
+    size_type old_capacity;
+    {
+      std::lock_guard<Mutex> lock(mutex_);
+      // Elements are trivially copyable, so the old ones need no destroy.
+      old_capacity = capacity_unlocked_();
+      old_start = std::exchange(start_, start);
+      end_ = start_ + count;
+      end_of_storage_ = end_;
+    }
+    if (old_start) {
+      std::allocator_traits<Allocator>::deallocate(allocator_, old_start,
+                                                   old_capacity);
+    }
+    notifier_.notify();
+  }
+
  private:
   pointer start_;
   pointer end_;
   pointer end_of_storage_;
   Allocator allocator_;
-  mutable std::shared_mutex mutex_;
+  mutable Mutex mutex_;
+  update_notifier notifier_;
 
   bool empty_unlocked_() const noexcept { return !(end_ - start_); }
+  const T* data_unlocked_() const noexcept {
+    return start_ ? std::addressof(*start_) : nullptr;
+  }
   size_type size_unlocked_() const noexcept { return end_ - start_; }
   size_type capacity_unlocked_() const noexcept {
     return end_of_storage_ - start_;
   }
+
+  /// @brief Moves the elements into a new buffer of new_cap elements.
+  void reallocate_unlocked_(const size_type new_cap) {
+    pointer start =
+        std::allocator_traits<Allocator>::allocate(allocator_, new_cap);
+    pointer end = start;
+    try {
+      for (pointer p = start_; p != end_; ++p, ++end) {
+        std::allocator_traits<Allocator>::construct(
+            allocator_, std::addressof(*end), std::move_if_noexcept(*p));
+      }
+    } catch (...) {
+      while (end != start) {
+        std::allocator_traits<Allocator>::destroy(allocator_,
+                                                  std::addressof(*--end));
+      }
+      std::allocator_traits<Allocator>::deallocate(allocator_, start, new_cap);
+      throw;
+    }
+
+    for (pointer p = start_; p != end_; ++p) {
+      std::allocator_traits<Allocator>::destroy(allocator_, std::addressof(*p));
+    }
+    if (start_) {
+      std::allocator_traits<Allocator>::deallocate(allocator_, start_,
+                                                   capacity_unlocked_());
+    }
+    start_ = start;
+    end_ = end;
+    end_of_storage_ = start + new_cap;
+  }
+
+  template <typename... Args>
+  void emplace_back_unlocked_(Args&&... args) {
+    if (end_ != end_of_storage_) {
+      std::allocator_traits<Allocator>::construct(
+          allocator_, std::addressof(*end_), std::forward<Args>(args)...);
+      ++end_;
+      return;
+    }
+
+    // Copy the new element first, since args may refer into the buffer that
+    // the reallocation is about to release.
+    T value(std::forward<Args>(args)...);
+    const size_type size = size_unlocked_();
+    reallocate_unlocked_(size ? 2 * size : 1);
+    std::allocator_traits<Allocator>::construct(
+        allocator_, std::addressof(*end_), std::move(value));
+    ++end_;
+  }
+
+  void erase_unlocked_(const size_type pos) {
+    if (pos >= size_unlocked_()) {
+      throw std::out_of_range("element access out of range");
+    }
+
+    std::move(start_ + pos + 1, end_, start_ + pos);
+    --end_;
+    std::allocator_traits<Allocator>::destroy(allocator_, std::addressof(*end_));
+  }
 };
 }  // namespace cds
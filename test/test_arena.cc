@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "cds_arena.h"
+#include "cds_vector.h"
+
+using cds::arena;
+using cds::arena_allocator;
+using cds::cds_vector;
+
+TEST(TestArena, TestAllocateAlignment) {
+  arena a(256);
+  for (std::size_t alignment = 1; alignment <= 64; alignment <<= 1) {
+    void* p = a.allocate(3, alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0);
+  }
+
+  // Requests larger than the chunk size get a dedicated chunk.
+  char* big = static_cast<char*>(a.allocate(4096, 8));
+  big[0] = 'a';
+  big[4095] = 'z';
+}
+
+TEST(TestArena, TestBumpAllocation) {
+  arena a;
+  char* p = static_cast<char*>(a.allocate(16, 1));
+  char* q = static_cast<char*>(a.allocate(16, 1));
+  EXPECT_EQ(p + 16, q);
+}
+
+TEST(TestArena, TestResetReusesMemory) {
+  arena a(128);
+  std::vector<void*> first;
+  for (int i = 0; i < 32; ++i) {
+    first.push_back(a.allocate(24, 8));
+  }
+
+  a.reset();
+  for (int i = 0; i < 32; ++i) {
+    EXPECT_EQ(a.allocate(24, 8), first[i]);
+  }
+
+  a.release();
+  void* p = a.allocate(24, 8);
+  EXPECT_NE(p, nullptr);
+}
+
+TEST(TestArena, TestAllocatorEquality) {
+  arena a;
+  arena b;
+  arena_allocator<int> x(a);
+  arena_allocator<double> y(x);
+  arena_allocator<int> z(b);
+  EXPECT_TRUE(x == y);
+  EXPECT_TRUE(x != z);
+  EXPECT_EQ(y.get_arena(), &a);
+}
+
+TEST(TestArena, TestWithVector) {
+  using vector = cds_vector<int, arena_allocator<int>>;
+  arena a;
+  for (int round = 0; round < 10; ++round) {
+    {
+      const std::size_t count = 100;
+      vector v(count, round, arena_allocator<int>(a));
+      EXPECT_EQ(v.size(), count);
+      EXPECT_EQ(v[99], round);
+
+      vector w = vector({1, 2, 3}, arena_allocator<int>(a));
+      EXPECT_EQ(w[2], 3);
+    }
+    a.reset();
+  }
+}
+
+TEST(TestArena, TestAllocatorExtendedCopy) {
+  using vector = cds_vector<int, arena_allocator<int>>;
+  arena a;
+  arena b;
+  vector v({1, 2, 3, 4, 5}, arena_allocator<int>(a));
+
+  vector w(v, arena_allocator<int>(b));
+  EXPECT_EQ(w.size(), 5);
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(v[i], w[i]);
+  }
+  EXPECT_NE(&*v.begin(), &*w.begin());
+
+  // Resetting the source arena leaves the copy intact.
+  a.reset();
+  a.allocate(64, 8);
+  EXPECT_EQ(w[4], 5);
+}
+
+TEST(TestArena, TestConcurrentAllocate) {
+  arena a(1024);
+  const std::size_t n_threads = 4;
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < n_threads; ++i) {
+    threads.emplace_back([&a, i]() {
+      for (std::size_t j = 0; j < 1000; ++j) {
+        std::size_t* p =
+            static_cast<std::size_t*>(a.allocate(sizeof(std::size_t), 8));
+        *p = i;
+        EXPECT_EQ(*p, i);
+      }
+    });
+  }
+
+  for (std::thread& t : threads) {
+    t.join();
+  }
+}
@@ -2,8 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "cds_array.h"
 
@@ -222,3 +226,110 @@ TEST(TestArray, TestStdSort) {
     }
   }
 }
+
+TEST(TestArray, TestFindCount) {
+  cds_array<int, 100> a{};
+  EXPECT_EQ(a.find(7), a.size());
+  EXPECT_EQ(a.count(0), 100);
+
+  a.set(40, 7);
+  a.set(95, 7);
+  EXPECT_EQ(a.find(7), 40);
+  EXPECT_EQ(a.count(7), 2);
+  EXPECT_EQ(a.count(0), 98);
+
+  cds_array<double, 3> b{1.0, 2.5, 2.5};
+  EXPECT_EQ(b.find(2.5), 1);
+  EXPECT_EQ(b.count(2.5), 2);
+}
+
+TEST(TestArray, TestMinMax) {
+  const cds_array<int, 5> a{5, 2, 17, -1, 0};
+  EXPECT_EQ(a.min(), -1);
+  EXPECT_EQ(a.max(), 17);
+}
+
+TEST(TestArray, TestEqual) {
+  cds_array<int, 3> a{1, 2, 3};
+  cds_array<int, 3> b{1, 2, 3};
+  EXPECT_TRUE(a.equal(b));
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a == a);
+  EXPECT_FALSE(a != b);
+
+  b.set(2, 4);
+  EXPECT_FALSE(a.equal(b));
+  EXPECT_TRUE(a != b);
+}
+
+TEST(TestArray, TestChangeTracking) {
+  cds_array<int, 8> a;
+  EXPECT_FALSE(a.tracking_changes());
+  std::vector<std::size_t> changed;
+  EXPECT_THROW(a.changes_since(0, std::back_inserter(changed)),
+               std::logic_error);
+  EXPECT_THROW(a.track_changes(0), std::invalid_argument);
+
+  a.track_changes();
+  EXPECT_TRUE(a.tracking_changes());
+  EXPECT_EQ(a.changes_since(0, std::back_inserter(changed)), 0);
+  EXPECT_TRUE(changed.empty());
+
+  a.set(3, 1);
+  a.set(6, 1);
+  const auto v1 = a.changes_since(0, std::back_inserter(changed));
+  EXPECT_EQ(changed, (std::vector<std::size_t>{3, 6}));
+
+  changed.clear();
+  {
+    auto write = a.new_scoped_write();
+    write[1] = 2;
+    write[7] = 2;
+  }
+  const auto v2 = a.changes_since(v1, std::back_inserter(changed));
+  EXPECT_EQ(v2, v1 + 1);
+  EXPECT_EQ(changed, (std::vector<std::size_t>{1, 7}));
+
+  changed.clear();
+  EXPECT_EQ(a.changes_since(v2, std::back_inserter(changed)), v2);
+  EXPECT_TRUE(changed.empty());
+
+  a.fill(0);
+  EXPECT_EQ(a.changes_since(v2, std::back_inserter(changed)), a.version());
+  EXPECT_EQ(changed.size(), 8);
+}
+
+TEST(TestArray, TestChangeTrackingStripes) {
+  cds_array<int, 10> a;
+  cds_array<int, 10> b;
+  a.track_changes(4);
+
+  std::vector<std::size_t> changed;
+  a.set(5, 1);
+  a.changes_since(0, std::back_inserter(changed));
+  EXPECT_EQ(changed, (std::vector<std::size_t>{4, 5, 6, 7}));
+
+  changed.clear();
+  const auto version = a.version();
+  a.swap(b);
+  a.changes_since(version, std::back_inserter(changed));
+  EXPECT_EQ(changed.size(), 10);
+  EXPECT_FALSE(b.tracking_changes());
+}
+
+TEST(TestArray, TestWaitForUpdate) {
+  cds_array<int, 4> a;
+  const auto seen = a.version();
+  EXPECT_EQ(a.wait_for_update(seen, std::chrono::milliseconds(1)), seen);
+
+  std::thread writer([&] { a.set(2, 5); });
+  const auto next = a.wait_for_update(seen);
+  writer.join();
+  EXPECT_NE(next, seen);
+  EXPECT_EQ(a.at(2), 5);
+
+  { auto write = a.new_scoped_write(); }
+  EXPECT_EQ(a.wait_for_update(next, std::chrono::seconds(10)), next + 1);
+  a.fill(1);
+  EXPECT_EQ(a.version(), next + 2);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cds_atomic_array.h"
+
+using cds::cds_atomic_array;
+
+static_assert(sizeof(cds_atomic_array<std::uint16_t, 4>) == 8);
+static_assert(sizeof(cds_atomic_array<std::uint8_t, 3>) == 4);
+static_assert(cds_atomic_array<std::uint16_t, 4>::is_always_lock_free);
+#if CDS_HAS_CMPXCHG16B
+static_assert(sizeof(cds_atomic_array<std::uint32_t, 4>) == 16);
+static_assert(cds_atomic_array<std::uint32_t, 4>::is_always_lock_free);
+#endif
+
+TEST(TestAtomicArray, TestAccess) {
+  cds_atomic_array<std::uint16_t, 4> arr{1, 2, 3};
+  EXPECT_EQ(arr.size(), 4);
+  EXPECT_EQ(arr[0], 1);
+  EXPECT_EQ(arr.at(2), 3);
+  EXPECT_EQ(arr.back(), 0);
+  EXPECT_THROW(arr.at(4), std::out_of_range);
+  EXPECT_THROW(arr.set(4, 1), std::out_of_range);
+
+  arr.set(3, 9);
+  EXPECT_EQ(arr.back(), 9);
+  arr.fill(7);
+  EXPECT_EQ((arr.load()), (std::array<std::uint16_t, 4>{7, 7, 7, 7}));
+
+  cds_atomic_array<std::uint16_t, 4> copy(arr);
+  EXPECT_EQ(copy, arr);
+  copy.set(0, 1);
+  EXPECT_NE(copy, arr);
+  copy = arr;
+  EXPECT_EQ(copy.front(), 7);
+}
+
+TEST(TestAtomicArray, TestCompareExchange) {
+  cds_atomic_array<std::uint32_t, 3> arr{1, 2, 3};
+  std::array<std::uint32_t, 3> expected{1, 2, 4};
+  EXPECT_FALSE(arr.compare_exchange(expected, {5, 5, 5}));
+  EXPECT_EQ(expected, (std::array<std::uint32_t, 3>{1, 2, 3}));
+  EXPECT_TRUE(arr.compare_exchange(expected, {5, 5, 5}));
+  EXPECT_EQ(arr.exchange({6, 6, 6}), (std::array<std::uint32_t, 3>{5, 5, 5}));
+  EXPECT_EQ(arr[1], 6);
+}
+
+TEST(TestAtomicArray, TestSwap) {
+  cds_atomic_array<std::int64_t, 2> a{1, 2};
+  cds_atomic_array<std::int64_t, 2> b{3, 4};
+  a.swap(b);
+  EXPECT_EQ(a[0], 3);
+  EXPECT_EQ(b[1], 2);
+}
+
+TEST(TestAtomicArray, TestConcurrentSet) {
+  // Each thread increments its own element; no update may be lost even
+  // though every set() replaces the whole word.
+  cds_atomic_array<std::uint32_t, 4> arr;
+  constexpr std::uint32_t iterations = 20000;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::uint32_t i = 1; i <= iterations; ++i) {
+        arr.set(t, i);
+        auto snapshot = arr.load();
+        EXPECT_EQ(snapshot[t], i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ((arr.load()), (std::array<std::uint32_t, 4>{
+                              iterations, iterations, iterations, iterations}));
+}
+
+TEST(TestAtomicArray, TestNoTornReads) {
+  cds_atomic_array<std::uint64_t, 2> arr;
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (std::uint64_t i = 1; i < 50000; ++i) {
+      arr.store({i, ~i});
+    }
+    done = true;
+  });
+  while (!done) {
+    const auto snapshot = arr.load();
+    ASSERT_EQ(snapshot[1], snapshot[0] ? ~snapshot[0] : 0);
+  }
+  writer.join();
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_bravo_shared_mutex.h"
+#include "cds_vector.h"
+
+using cds::bravo_shared_mutex;
+
+TEST(TestBravoSharedMutex, TestBiasLifecycle) {
+  bravo_shared_mutex m;
+  EXPECT_FALSE(m.read_biased());
+
+  // The first slow-path reader enables the bias.
+  m.lock_shared();
+  EXPECT_TRUE(m.read_biased());
+  m.unlock_shared();
+
+  // A fast-path reader blocks writers but not other readers.
+  m.lock_shared();
+  EXPECT_FALSE(m.try_lock());
+  EXPECT_TRUE(m.try_lock_shared());
+  m.unlock_shared();
+  m.unlock_shared();
+
+  // A writer revokes the bias.
+  m.lock();
+  EXPECT_FALSE(m.read_biased());
+  EXPECT_FALSE(m.try_lock_shared());
+  m.unlock();
+}
+
+TEST(TestBravoSharedMutex, TestFailedTryLockRevokesBias) {
+  bravo_shared_mutex m;
+  m.lock_shared();
+  m.unlock_shared();
+  ASSERT_TRUE(m.read_biased());
+
+  std::atomic<bool> holding{false};
+  std::atomic<bool> release{false};
+  std::thread reader([&] {
+    m.lock_shared();
+    holding = true;
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+    m.unlock_shared();
+  });
+  while (!holding.load()) {
+    std::this_thread::yield();
+  }
+
+  // The fast-path reader is still there after the bias is off, so every
+  // attempt fails, and each failure widens the inhibit window.
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_FALSE(m.try_lock());
+    EXPECT_FALSE(m.read_biased());
+  }
+  release = true;
+  reader.join();
+
+  // Slow-path readers do not restore the bias within the window.
+  m.lock_shared();
+  EXPECT_FALSE(m.read_biased());
+  m.unlock_shared();
+  EXPECT_TRUE(m.try_lock());
+  m.unlock();
+}
+
+TEST(TestBravoSharedMutex, TestNestedLocks) {
+  // One thread may hold several BRAVO locks in shared mode at once.
+  bravo_shared_mutex a;
+  bravo_shared_mutex b;
+  for (int i = 0; i < 2; ++i) {
+    std::shared_lock<bravo_shared_mutex> ra(a);
+    std::shared_lock<bravo_shared_mutex> rb(b);
+  }
+  std::scoped_lock both(a, b);
+}
+
+TEST(TestBravoSharedMutex, TestMutualExclusion) {
+  bravo_shared_mutex m;
+  long value = 0;
+  std::atomic<bool> torn{false};
+  constexpr int iterations = 20000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < iterations; ++i) {
+        std::lock_guard<bravo_shared_mutex> lock(m);
+        ++value;
+        ++value;
+      }
+    });
+  }
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < iterations; ++i) {
+        std::shared_lock<bravo_shared_mutex> lock(m);
+        if (value % 2) {
+          torn = true;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_FALSE(torn);
+  EXPECT_EQ(value, 4L * iterations);
+}
+
+TEST(TestBravoSharedMutex, TestContainers) {
+  cds::cds_array<int, 4, bravo_shared_mutex> arr{1, 2, 3, 4};
+  arr.set(0, 5);
+  EXPECT_EQ(arr.at(0), 5);
+  cds::cds_array<int, 4, bravo_shared_mutex> other{0, 0, 0, 0};
+  arr.swap(other);
+  EXPECT_EQ(other.find(5), 0);
+  EXPECT_FALSE(arr == other);
+
+  cds::cds_vector<int, std::allocator<int>, bravo_shared_mutex> vec;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        if (t == 0) {
+          vec.push_back(i);
+        } else {
+          auto read = vec.new_scoped_read();
+          if (read.size()) {
+            EXPECT_EQ(read.back(), static_cast<int>(read.size()) - 1);
+          }
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(vec.size(), 1000);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_cohort_lock.h"
+#include "cds_numa.h"
+#include "cds_vector.h"
+
+using cds::cohort_lock;
+
+namespace {
+void expect_mutual_exclusion(cohort_lock& lock) {
+  long value = 0;
+  constexpr int threads = 4;
+  constexpr int iterations = 20000;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&] {
+      for (int i = 0; i < iterations; ++i) {
+        cds::cohort_guard guard(lock);
+        ++value;
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  EXPECT_EQ(value, static_cast<long>(threads) * iterations);
+}
+}  // namespace
+
+TEST(TestCohortLock, TestNodeCount) {
+  cohort_lock lock;
+  EXPECT_EQ(lock.node_count(), cds::numa_topology::instance().node_count());
+}
+
+TEST(TestCohortLock, TestMutualExclusion) {
+  cohort_lock lock;
+  expect_mutual_exclusion(lock);
+}
+
+TEST(TestCohortLock, TestNoLocalPasses) {
+  // Every release hands the global lock back.
+  cohort_lock lock(0);
+  expect_mutual_exclusion(lock);
+}
+
+TEST(TestCohortLock, TestHandoffToWaiter) {
+  // The waiter is handed the lock, possibly together with the global lock,
+  // and nobody else gets in until it releases both.
+  cohort_lock lock(1000);
+  lock.lock();
+  std::atomic<bool> acquired{false};
+  std::thread waiter([&] {
+    cds::cohort_guard guard(lock);
+    acquired = true;
+    while (acquired.load()) {
+      std::this_thread::yield();
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  std::thread([&] { EXPECT_FALSE(lock.try_lock()); }).join();
+  lock.unlock();
+  while (!acquired.load()) {
+    std::this_thread::yield();
+  }
+  std::thread([&] { EXPECT_FALSE(lock.try_lock()); }).join();
+  acquired = false;
+  waiter.join();
+
+  EXPECT_TRUE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST(TestCohortLock, TestTryLock) {
+  cohort_lock lock;
+  EXPECT_TRUE(lock.try_lock());
+  std::thread([&] { EXPECT_FALSE(lock.try_lock()); }).join();
+  lock.unlock();
+  {
+    cds::cohort_guard guard(lock);
+  }
+  EXPECT_TRUE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST(TestCohortLock, TestTryLockMutualExclusion) {
+  // Data written under a lock taken with try_lock() must be visible to the
+  // next owner, however it acquires the lock.
+  cohort_lock lock;
+  long value = 0;
+  constexpr int threads = 4;
+  constexpr int iterations = 5000;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < iterations; ++i) {
+        if (t % 2) {
+          while (!lock.try_lock()) {
+            std::this_thread::yield();
+          }
+        } else {
+          lock.lock();
+        }
+        ++value;
+        lock.unlock();
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  EXPECT_EQ(value, static_cast<long>(threads) * iterations);
+}
+
+TEST(TestCohortLock, TestContainers) {
+  using cds::cohort_shared_mutex;
+
+  cds::cds_array<int, 4, cohort_shared_mutex> a{1, 2, 3, 4};
+  cds::cds_array<int, 4, cohort_shared_mutex> b{5, 6, 7, 8};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        if (t % 2) {
+          a.swap(b);
+        } else {
+          b.swap(a);
+        }
+        EXPECT_FALSE(a == b);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(a.at(0) + b.at(0), 6);
+
+  cds::cds_vector<int, std::allocator<int>, cohort_shared_mutex> vec;
+  threads.clear();
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(vec.size(), 4000);
+}
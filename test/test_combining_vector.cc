@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cds_combining_vector.h"
+
+using cds::cds_combining_vector;
+
+TEST(TestCombiningVector, TestSingleThread) {
+  cds_combining_vector<int> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  EXPECT_EQ(v.size(), 3);
+
+  v.set(0, 10);
+  v.erase(1);
+  auto read = v.new_scoped_read();
+  EXPECT_EQ(read.size(), 2);
+  EXPECT_EQ(read[0], 10);
+  EXPECT_EQ(read[1], 3);
+}
+
+TEST(TestCombiningVector, TestErrorsReachCaller) {
+  cds_combining_vector<int> v(4);
+  EXPECT_THROW(v.set(0, 1), std::out_of_range);
+  EXPECT_THROW(v.erase(0), std::out_of_range);
+  v.push_back(5);
+  EXPECT_EQ(v.vector()[0], 5);
+}
+
+TEST(TestCombiningVector, TestConcurrentWriters) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 2000;
+  // Fewer slots than threads exercises slot sharing.
+  cds_combining_vector<int> v(4);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&v, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        v.push_back(t * kPerThread + i);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(v.size(), static_cast<std::size_t>(kThreads * kPerThread));
+  auto write = v.vector().new_scoped_write();
+  std::vector<int> values(v.vector().begin(), v.vector().end());
+  std::sort(values.begin(), values.end());
+  for (int i = 0; i < kThreads * kPerThread; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+TEST(TestCombiningVector, TestConcurrentMixedOps) {
+  constexpr int kThreads = 6;
+  constexpr int kOps = 1000;
+  cds_combining_vector<int> v;
+  for (int i = 0; i < kThreads; ++i) {
+    v.push_back(0);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&v, t] {
+      for (int i = 0; i < kOps; ++i) {
+        v.set(static_cast<std::size_t>(t), i);
+        v.push_back(-1);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  auto read = v.new_scoped_read();
+  EXPECT_EQ(read.size(), static_cast<std::size_t>(kThreads * (kOps + 1)));
+  for (int t = 0; t < kThreads; ++t) {
+    EXPECT_EQ(read[t], kOps - 1);
+  }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cds_delta_array.h"
+
+using cds::cds_delta_array;
+
+TEST(TestDeltaArray, TestMerge) {
+  cds_delta_array<int, 4> arr;
+  arr.add(0, 5);
+  arr.add(0, -2);
+  arr.add(3, 1);
+  EXPECT_THROW(arr.add(4, 1), std::out_of_range);
+
+  // Reads are stale until a merge.
+  EXPECT_EQ(arr.at(0), 0);
+  arr.merge();
+  EXPECT_EQ(arr.at(0), 3);
+  EXPECT_EQ(arr.at(3), 1);
+
+  arr.add(1, -7);
+  EXPECT_EQ(arr.at(1), 0);
+  EXPECT_EQ(arr.at_merged(1), -7);
+  EXPECT_THROW(arr.at(4), std::out_of_range);
+}
+
+TEST(TestDeltaArray, TestFloatingPoint) {
+  cds_delta_array<double, 2> arr;
+  arr.add(1, 0.5);
+  arr.add(1, 0.25);
+  EXPECT_DOUBLE_EQ(arr.at_merged(1), 0.75);
+}
+
+TEST(TestDeltaArray, TestLargeFloatingPointTotals) {
+  // A float running total stops absorbing 1.0 at 2^24.
+  cds_delta_array<float, 1> arr;
+  for (int i = 0; i < 20000000; ++i) {
+    arr.add(0, 1.0f);
+    if (i % 1000 == 999) {
+      arr.merge();
+    }
+  }
+  EXPECT_EQ(arr.at_merged(0), 20000000.0f);
+}
+
+TEST(TestDeltaArray, TestManyShortLivedArrays) {
+  // Each array leaves an entry in this thread's shadow map; entries of
+  // destroyed arrays are pruned as the map grows.
+  for (int i = 0; i < 10000; ++i) {
+    cds_delta_array<int, 2> arr;
+    arr.add(i % 2, i);
+    EXPECT_EQ(arr.at_merged(i % 2), i);
+  }
+}
+
+TEST(TestDeltaArray, TestFlushInterval) {
+  cds_delta_array<std::uint32_t, 2> arr(3);
+  arr.add(0, 1);
+  arr.add(0, 1);
+  EXPECT_EQ(arr.at(0), 0);
+  arr.add(1, 1);
+  EXPECT_EQ(arr.at(0), 2);
+  EXPECT_EQ(arr.at(1), 1);
+}
+
+TEST(TestDeltaArray, TestMergeNotifiesUnderlyingArray) {
+  cds_delta_array<std::int64_t, 8> arr;
+  arr.array().track_changes();
+  const auto version = arr.array().version();
+  arr.add(5, 1);
+  arr.merge();
+  EXPECT_NE(arr.array().version(), version);
+
+  std::vector<std::size_t> changed;
+  arr.array().changes_since(0, std::back_inserter(changed));
+  EXPECT_EQ(changed, std::vector<std::size_t>{5});
+}
+
+namespace {
+template <typename T>
+void expect_concurrent_adds() {
+  cds_delta_array<T, 16> arr(1000);
+  constexpr int threads = 4;
+  constexpr int iterations = 100000;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < iterations; ++i) {
+        arr.add(static_cast<std::size_t>(i + t) % 16, 1);
+      }
+    });
+  }
+  // A concurrent merger must not lose or double-count anything.
+  std::thread merger([&] {
+    for (int i = 0; i < 100; ++i) {
+      arr.merge();
+    }
+  });
+  for (auto& w : workers) {
+    w.join();
+  }
+  merger.join();
+
+  T total = 0;
+  for (std::size_t pos = 0; pos < arr.size(); ++pos) {
+    total += arr.at_merged(pos);
+  }
+  EXPECT_EQ(total, static_cast<T>(threads) * iterations);
+}
+}  // namespace
+
+TEST(TestDeltaArray, TestConcurrentAdds) {
+  expect_concurrent_adds<std::int64_t>();
+  expect_concurrent_adds<double>();
+}
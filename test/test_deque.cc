@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cds_deque.h"
+#include "cds_pool_allocator.h"
+
+using cds::cds_deque;
+
+namespace {
+struct MoveCounter {
+  MoveCounter() = default;
+  MoveCounter(MoveCounter&&) noexcept { ++moves; }
+  static inline int moves = 0;
+};
+}  // namespace
+
+TEST(TestDeque, TestBothEnds) {
+  cds_deque<std::string> d;
+  EXPECT_TRUE(d.empty());
+  EXPECT_FALSE(d.try_pop_front());
+  EXPECT_FALSE(d.try_pop_back());
+
+  d.push_back("b");
+  d.push_front("a");
+  d.emplace_back(1, 'c');
+  EXPECT_EQ(d.size(), 3);
+
+  EXPECT_EQ(*d.try_pop_front(), "a");
+  EXPECT_EQ(*d.try_pop_back(), "c");
+  EXPECT_EQ(*d.try_pop_back(), "b");
+  EXPECT_TRUE(d.empty());
+  EXPECT_FALSE(d.try_pop_front());
+}
+
+TEST(TestDeque, TestCrossesChunks) {
+  cds_deque<int> d;
+  const int n = static_cast<int>(cds_deque<int>::chunk_elements) * 3;
+  for (int i = 0; i < n; ++i) {
+    d.push_back(i);
+    d.push_front(-i - 1);
+  }
+  EXPECT_EQ(d.size(), static_cast<std::size_t>(n) * 2);
+
+  // Pop everything from one end, walking through every chunk.
+  for (int i = n; i > 0; --i) {
+    EXPECT_EQ(*d.try_pop_front(), -i);
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    EXPECT_EQ(*d.try_pop_back(), i);
+  }
+  EXPECT_FALSE(d.try_pop_back());
+
+  // Then refill across the original chunk boundary from the other side.
+  for (int i = 0; i < n; ++i) {
+    d.push_front(i);
+  }
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(*d.try_pop_back(), i);
+  }
+  EXPECT_TRUE(d.empty());
+}
+
+TEST(TestDeque, TestElementsAreNotRelocated) {
+  cds_deque<MoveCounter> d;
+  for (int i = 0; i < 1000; ++i) {
+    d.emplace_back();
+    d.emplace_front();
+  }
+  // Growing at either end never moves stored elements.
+  EXPECT_EQ(MoveCounter::moves, 0);
+  for (int i = 0; i < 500; ++i) {
+    d.try_pop_front();
+    d.try_pop_back();
+  }
+  EXPECT_EQ(d.size(), 1000);
+}
+
+TEST(TestDeque, TestDestroysRemaining) {
+  auto shared = std::make_shared<int>(1);
+  {
+    cds_deque<std::shared_ptr<int>> d;
+    for (std::size_t i = 0; i < cds_deque<int>::chunk_elements * 2; ++i) {
+      d.push_back(shared);
+      d.push_front(shared);
+    }
+    d.try_pop_front();
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(TestDeque, TestPoolAllocator) {
+  cds_deque<int, cds::pool_allocator<int>> d;
+  for (int i = 0; i < 5000; ++i) {
+    d.push_back(i);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    EXPECT_EQ(*d.try_pop_front(), i);
+  }
+}
+
+TEST(TestDeque, TestProducerConsumer) {
+  cds_deque<int> d;
+  constexpr int count = 100000;
+
+  std::thread producer([&] {
+    for (int i = 0; i < count; ++i) {
+      d.push_back(i);
+    }
+  });
+
+  int expected = 0;
+  while (expected < count) {
+    if (std::optional<int> v = d.try_pop_front()) {
+      ASSERT_EQ(*v, expected);
+      ++expected;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(d.empty());
+}
+
+TEST(TestDeque, TestBothEndsConcurrent) {
+  cds_deque<int> d;
+  constexpr int count = 50000;
+  std::atomic<long> popped_sum{0};
+  std::atomic<int> popped{0};
+
+  std::vector<std::thread> threads;
+  threads.emplace_back([&] {
+    for (int i = 1; i <= count; ++i) {
+      d.push_back(i);
+    }
+  });
+  threads.emplace_back([&] {
+    for (int i = 1; i <= count; ++i) {
+      d.push_front(i);
+    }
+  });
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t] {
+      while (popped.load() < count * 2) {
+        std::optional<int> v = t ? d.try_pop_back() : d.try_pop_front();
+        if (v) {
+          popped_sum += *v;
+          ++popped;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(popped.load(), count * 2);
+  EXPECT_EQ(popped_sum.load(), static_cast<long>(count) * (count + 1));
+  EXPECT_TRUE(d.empty());
+}
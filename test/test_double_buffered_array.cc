@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cds_double_buffered_array.h"
+
+using cds::double_buffered_array;
+
+TEST(TestDoubleBufferedArray, TestConstruct) {
+  double_buffered_array<int, 4> arr;
+  EXPECT_EQ(arr.size(), 4);
+  for (std::size_t i = 0; i < arr.size(); ++i) {
+    EXPECT_EQ(arr[i], 0);
+  }
+  EXPECT_THROW(arr.at(4), std::out_of_range);
+}
+
+TEST(TestDoubleBufferedArray, TestWritesInvisibleUntilPublish) {
+  double_buffered_array<int, 4> arr;
+  auto write = arr.new_scoped_write();
+  for (std::size_t i = 0; i < 4; ++i) {
+    write[i] = static_cast<int>(i + 1);
+  }
+  EXPECT_EQ(arr[0], 0);
+  EXPECT_EQ(arr[3], 0);
+
+  write.publish();
+  for (std::size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(arr[i], static_cast<int>(i + 1));
+  }
+}
+
+TEST(TestDoubleBufferedArray, TestSync) {
+  double_buffered_array<int, 3> arr;
+  auto write = arr.new_scoped_write();
+  write[0] = 1;
+  write[1] = 2;
+  write[2] = 3;
+  write.publish();
+
+  // The new back buffer is the old, zeroed front until synced.
+  EXPECT_EQ(write[1], 0);
+  write.sync();
+  write[1] = 20;
+  write.publish();
+  EXPECT_EQ(arr[0], 1);
+  EXPECT_EQ(arr[1], 20);
+  EXPECT_EQ(arr[2], 3);
+  EXPECT_THROW(write.at(3), std::out_of_range);
+}
+
+TEST(TestDoubleBufferedArray, TestScopedReadKeepsSnapshot) {
+  double_buffered_array<int, 2> arr;
+  auto read = arr.new_scoped_read();
+  {
+    // Publishing does not wait for the pinned reader.
+    auto write = arr.new_scoped_write();
+    write[0] = 7;
+    write[1] = 8;
+    write.publish();
+  }
+  EXPECT_EQ(read[0], 0);
+  EXPECT_EQ(read[1], 0);
+  EXPECT_EQ(arr[0], 7);
+  EXPECT_EQ(arr[1], 8);
+  EXPECT_THROW(read.at(2), std::out_of_range);
+}
+
+TEST(TestDoubleBufferedArray, TestConcurrentFrames) {
+  // Every published frame holds a single value in all slots, so a reader
+  // that ever sees a mixed frame has observed a torn write.
+  constexpr std::size_t kSize = 256;
+  constexpr int kFrames = 2000;
+  double_buffered_array<int, kSize> arr;
+  std::atomic<bool> done(false);
+  std::atomic<bool> torn(false);
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&] {
+      int last = 0;
+      while (!done.load()) {
+        auto read = arr.new_scoped_read();
+        const int frame = read[0];
+        for (const int value : read) {
+          if (value != frame) {
+            torn = true;
+          }
+        }
+        if (frame < last) {
+          torn = true;
+        }
+        last = frame;
+      }
+    });
+  }
+
+  {
+    auto write = arr.new_scoped_write();
+    for (int frame = 1; frame <= kFrames; ++frame) {
+      for (int& value : write) {
+        value = frame;
+      }
+      write.publish();
+    }
+  }
+  done = true;
+  for (std::thread& t : readers) {
+    t.join();
+  }
+
+  EXPECT_FALSE(torn.load());
+  EXPECT_EQ(arr[kSize - 1], kFrames);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cds_huge_page_allocator.h"
+#include "cds_vector.h"
+
+using cds::cds_vector;
+using cds::huge_page_allocator;
+using cds::huge_page_options;
+using cds::numa_placement;
+using cds::page_size;
+
+namespace {
+void fill_and_check(huge_page_allocator<std::uint64_t> alloc,
+                    const std::size_t n) {
+  std::uint64_t* p = alloc.allocate(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    p[i] = i;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(p[i], i);
+  }
+  alloc.deallocate(p, n);
+}
+}  // namespace
+
+TEST(TestHugePageAllocator, TestPageSizes) {
+  const std::size_t n = (std::size_t(4) << 20) / sizeof(std::uint64_t);
+  for (const page_size pages :
+       {page_size::standard, page_size::huge_2mb, page_size::huge_1gb}) {
+    huge_page_options options;
+    options.pages = pages;
+    fill_and_check(huge_page_allocator<std::uint64_t>(options), n);
+  }
+}
+
+TEST(TestHugePageAllocator, TestSmallAllocations) {
+  fill_and_check(huge_page_allocator<std::uint64_t>(), 1);
+  fill_and_check(huge_page_allocator<std::uint64_t>(), 511);
+  fill_and_check(huge_page_allocator<std::uint64_t>(), 513);
+
+  // Smaller than a huge page, so mapped with regular pages.
+  huge_page_options options;
+  options.pages = page_size::huge_1gb;
+  for (int i = 0; i < 64; ++i) {
+    fill_and_check(huge_page_allocator<std::uint64_t>(options), 640);
+  }
+}
+
+TEST(TestHugePageAllocator, TestNumaPlacement) {
+  const std::size_t n = (std::size_t(2) << 20) / sizeof(std::uint64_t);
+  huge_page_options options;
+  options.placement = numa_placement::bind;
+  options.node = cds::numa_topology::instance().current_node();
+  fill_and_check(huge_page_allocator<std::uint64_t>(options), n);
+
+  options.placement = numa_placement::interleave;
+  fill_and_check(huge_page_allocator<std::uint64_t>(options), n);
+
+  // Binding to a node that does not exist falls back to default placement.
+  options.placement = numa_placement::bind;
+  options.node = 4096;
+  fill_and_check(huge_page_allocator<std::uint64_t>(options), n);
+}
+
+TEST(TestHugePageAllocator, TestEquality) {
+  huge_page_options options;
+  options.pages = page_size::standard;
+  huge_page_allocator<int> a(options);
+  huge_page_allocator<double> b(a);
+  huge_page_allocator<int> c;
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != c);
+}
+
+TEST(TestHugePageAllocator, TestWithVector) {
+  using vector = cds_vector<int, huge_page_allocator<int>>;
+  const std::size_t count = 1 << 20;
+  vector a(count, 7);
+  EXPECT_EQ(a.size(), count);
+  EXPECT_EQ(a[0], 7);
+  EXPECT_EQ(a[count - 1], 7);
+
+  vector b(a);
+  EXPECT_EQ(b[count / 2], 7);
+}
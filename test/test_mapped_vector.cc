@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "cds_mapped_vector.h"
+
+using cds::cds_mapped_vector;
+
+namespace {
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+// Removes the backing file when a test ends.
+class TempFile {
+ public:
+  explicit TempFile(const std::string& name)
+      : path_(testing::TempDir() + name) {
+    std::remove(path_.c_str());
+  }
+  ~TempFile() { std::remove(path_.c_str()); }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+}  // namespace
+
+TEST(TestMappedVector, TestCreate) {
+  TempFile file("cds_mapped_create.bin");
+  auto vec = cds_mapped_vector<int>::create(file.path(), 4, 7);
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_FALSE(vec.empty());
+  EXPECT_GE(vec.capacity(), 4);
+  for (std::size_t i = 0; i < vec.size(); ++i) {
+    EXPECT_EQ(vec[i], 7);
+  }
+  EXPECT_THROW(vec.at(4), std::out_of_range);
+}
+
+TEST(TestMappedVector, TestReopen) {
+  TempFile file("cds_mapped_reopen.bin");
+  {
+    auto vec = cds_mapped_vector<Point>::create(file.path());
+    EXPECT_TRUE(vec.empty());
+    for (std::int32_t i = 0; i < 1000; ++i) {
+      vec.push_back({i, -i});
+    }
+    vec.set(0, {42, 43});
+    vec.flush();
+  }
+
+  auto vec = cds_mapped_vector<Point>::open_existing(file.path());
+  ASSERT_EQ(vec.size(), 1000);
+  EXPECT_EQ(vec[0].x, 42);
+  EXPECT_EQ(vec[0].y, 43);
+  EXPECT_EQ(vec[999].x, 999);
+  EXPECT_EQ(vec[999].y, -999);
+}
+
+TEST(TestMappedVector, TestResizeReserve) {
+  TempFile file("cds_mapped_resize.bin");
+  auto vec = cds_mapped_vector<std::uint64_t>::create(file.path(), 2, 1);
+  vec.reserve(100);
+  EXPECT_GE(vec.capacity(), 100);
+  EXPECT_EQ(vec.size(), 2);
+
+  vec.resize(5, 9);
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec[1], 1);
+  EXPECT_EQ(vec[4], 9);
+
+  vec.resize(1);
+  EXPECT_EQ(vec.size(), 1);
+}
+
+TEST(TestMappedVector, TestReserveTooLarge) {
+  TempFile file("cds_mapped_too_large.bin");
+  auto vec = cds_mapped_vector<std::uint64_t>::create(file.path(), 3, 7);
+  const std::size_t capacity = vec.capacity();
+
+  // The byte count would wrap around to a small size.
+  const std::size_t huge = SIZE_MAX / sizeof(std::uint64_t);
+  EXPECT_THROW(vec.reserve(huge), std::length_error);
+  EXPECT_THROW(vec.resize(huge), std::length_error);
+  EXPECT_THROW(cds_mapped_vector<std::uint64_t>::create(file.path(), huge),
+               std::length_error);
+
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.capacity(), capacity);
+  EXPECT_EQ(vec[0], 7);
+  EXPECT_EQ(vec[2], 7);
+  vec.push_back(8);
+  EXPECT_EQ(vec[3], 8);
+}
+
+TEST(TestMappedVector, TestScopedAccess) {
+  TempFile file("cds_mapped_scoped.bin");
+  auto vec = cds_mapped_vector<int>::create(file.path(), 3);
+  {
+    auto write = vec.new_scoped_write();
+    write[0] = 1;
+    write[2] = 3;
+    write.push_back(4);
+    EXPECT_EQ(write.size(), 4);
+  }
+  {
+    auto read = vec.new_scoped_read();
+    EXPECT_EQ(read[0], 1);
+    EXPECT_EQ(read[1], 0);
+    EXPECT_EQ(read[3], 4);
+    EXPECT_THROW(read.at(4), std::out_of_range);
+  }
+
+  int sum = 0;
+  auto write = vec.new_scoped_write();
+  for (const int value : vec) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 8);
+}
+
+TEST(TestMappedVector, TestOpenRejectsBadFiles) {
+  TempFile missing("cds_mapped_missing.bin");
+  EXPECT_THROW(cds_mapped_vector<int>::open_existing(missing.path()),
+               std::system_error);
+
+  TempFile garbage("cds_mapped_garbage.bin");
+  {
+    std::ofstream out(garbage.path(), std::ios::binary);
+    out << std::string(128, 'x');
+  }
+  EXPECT_THROW(cds_mapped_vector<int>::open_existing(garbage.path()),
+               std::runtime_error);
+
+  TempFile wrong_type("cds_mapped_wrong_type.bin");
+  cds_mapped_vector<int>::create(wrong_type.path(), 4);
+  EXPECT_THROW(cds_mapped_vector<Point>::open_existing(wrong_type.path()),
+               std::runtime_error);
+}
+
+TEST(TestMappedVector, TestOpenRejectsZeroCapacity) {
+  // A hand-written header with no room for elements must not be mapped,
+  // or the first push_back would write past the end of the file.
+  TempFile empty("cds_mapped_zero_capacity.bin");
+  {
+    cds::detail::mapped_header header{};
+    header.magic = cds::detail::mapped_magic;
+    header.format_version = cds::detail::mapped_format_version;
+    header.element_size = sizeof(int);
+    header.size = 0;
+    header.capacity = 0;
+    std::string bytes(cds::detail::mapped_header_size, '\0');
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::ofstream out(empty.path(), std::ios::binary);
+    out << bytes;
+  }
+  EXPECT_THROW(cds_mapped_vector<int>::open_existing(empty.path()),
+               std::runtime_error);
+
+  TempFile huge("cds_mapped_huge_capacity.bin");
+  {
+    cds::detail::mapped_header header{};
+    header.magic = cds::detail::mapped_magic;
+    header.format_version = cds::detail::mapped_format_version;
+    header.element_size = sizeof(int);
+    header.size = 0;
+    // capacity * sizeof(int) wraps to zero.
+    header.capacity = UINT64_MAX / sizeof(int) + 1;
+    std::string bytes(cds::detail::mapped_header_size, '\0');
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::ofstream out(huge.path(), std::ios::binary);
+    out << bytes;
+  }
+  EXPECT_THROW(cds_mapped_vector<int>::open_existing(huge.path()),
+               std::runtime_error);
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cds_numa.h"
+
+using cds::numa_topology;
+
+TEST(TestNuma, TestParseList) {
+  EXPECT_EQ(numa_topology::parse_list("0-3,8,10-11"),
+            (std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(numa_topology::parse_list("5"), (std::vector<unsigned>{5}));
+  EXPECT_TRUE(numa_topology::parse_list("").empty());
+}
+
+TEST(TestNuma, TestTopology) {
+  const numa_topology& topology = numa_topology::instance();
+  EXPECT_GE(topology.node_count(), 1);
+  EXPECT_LT(topology.current_node(), topology.node_count());
+  for (unsigned i = 0; i < 2 * numa_topology::node_refresh_interval; ++i) {
+    EXPECT_LT(topology.cached_current_node(), topology.node_count());
+  }
+
+  std::size_t n_cpus = 0;
+  for (std::size_t node = 0; node < topology.node_count(); ++node) {
+    for (const unsigned cpu : topology.cpus(node)) {
+      EXPECT_EQ(topology.node_of_cpu(cpu), node);
+      ++n_cpus;
+    }
+  }
+  EXPECT_GE(n_cpus, 1);
+  EXPECT_TRUE(topology.cpus(topology.node_count()).empty());
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_parallel.h"
+#include "cds_vector.h"
+
+using cds::cds_array;
+using cds::cds_vector;
+namespace parallel = cds::parallel;
+
+namespace {
+// Small grain so that the tests exercise several threads.
+const parallel::execution_policy policy(4, 16);
+}  // namespace
+
+TEST(TestParallel, TestParallelFor) {
+  std::vector<int> hits(1000, 0);
+  policy.parallel_for(0, hits.size(), 0,
+                      [&hits](const std::size_t b, const std::size_t e) {
+                        for (std::size_t i = b; i < e; ++i) {
+                          ++hits[i];
+                        }
+                      });
+  for (const int hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+
+  EXPECT_THROW(policy.parallel_for(0, 1000, 0,
+                                   [](std::size_t b, std::size_t) {
+                                     if (b > 0) {
+                                       throw std::runtime_error("chunk");
+                                     }
+                                   }),
+               std::runtime_error);
+}
+
+TEST(TestParallel, TestChangeTracking) {
+  cds_array<int, 100> a{};
+  cds_array<int, 100> b{};
+  a.track_changes(10);
+  std::vector<std::size_t> changed;
+
+  auto version = a.version();
+  parallel::fill(policy, a, 3);
+  version = a.changes_since(version, std::back_inserter(changed));
+  EXPECT_EQ(changed.size(), 100);
+
+  changed.clear();
+  parallel::for_each(policy, a, [](int& x) { ++x; });
+  version = a.changes_since(version, std::back_inserter(changed));
+  EXPECT_EQ(changed.size(), 100);
+
+  changed.clear();
+  parallel::transform(policy, b, a, [](const int x) { return x + 1; });
+  version = a.changes_since(version, std::back_inserter(changed));
+  EXPECT_EQ(changed.size(), 100);
+
+  // Reads are not changes.
+  changed.clear();
+  parallel::reduce(policy, a, 0);
+  EXPECT_EQ(a.changes_since(version, std::back_inserter(changed)), version);
+  EXPECT_TRUE(changed.empty());
+}
+
+TEST(TestParallel, TestForEachFill) {
+  cds_array<int, 1000> a{};
+  parallel::fill(policy, a, 3);
+  parallel::for_each(policy, a, [](int& x) { x *= 2; });
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a[i], 6);
+  }
+
+  const std::size_t count = 1000;
+  cds_vector<int> v(count, 1);
+  parallel::for_each(parallel::par, v, [](int& x) { ++x; });
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(v[i], 2);
+  }
+}
+
+TEST(TestParallel, TestTransform) {
+  cds_array<int, 500> a{};
+  {
+    auto write = a.new_scoped_write();
+    std::iota(a.begin(), a.end(), 0);
+  }
+  parallel::transform(policy, a, [](const int x) { return x * x; });
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a[i], static_cast<int>(i * i));
+  }
+
+  const std::size_t count = 500;
+  cds_vector<long> v(count, 0);
+  parallel::transform(policy, a, v, [](const int x) { return -long(x); });
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(v[i], -static_cast<long>(i * i));
+  }
+
+  cds_vector<long> small(count / 2, 0);
+  EXPECT_THROW(parallel::transform(policy, a, small, [](int x) { return x; }),
+               std::length_error);
+}
+
+TEST(TestParallel, TestReduce) {
+  const std::size_t count = 10000;
+  cds_vector<long> v(count, 2);
+  EXPECT_EQ(parallel::reduce(policy, v, 0L), 20000);
+
+  cds_vector<long> empty;
+  EXPECT_EQ(parallel::reduce(policy, empty, 5L), 5);
+
+  cds_array<double, 100> a{};
+  parallel::fill(policy, a, 0.5);
+  EXPECT_DOUBLE_EQ(parallel::reduce(policy, a, 1.0), 51.0);
+  EXPECT_DOUBLE_EQ(parallel::reduce(policy, a, 1.0, std::multiplies<>()),
+                   std::pow(0.5, 100));
+}
+
+TEST(TestParallel, TestSort) {
+  std::vector<int> source(5000);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  for (int& x : source) {
+    x = dist(gen);
+  }
+
+  cds_vector<int> v(source.begin(), source.end());
+  parallel::sort(policy, v);
+  std::sort(source.begin(), source.end());
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    EXPECT_EQ(v[i], source[i]);
+  }
+
+  parallel::sort(parallel::execution_policy(3, 7), v, std::greater<>());
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    EXPECT_EQ(v[i], source[source.size() - 1 - i]);
+  }
+}
+
+TEST(TestParallel, TestFindIf) {
+  cds_array<int, 1000> a{};
+  EXPECT_EQ(parallel::find_if(policy, a, [](int x) { return x != 0; }), 1000);
+
+  a.set(700, 1);
+  a.set(900, 1);
+  EXPECT_EQ(parallel::find_if(policy, a, [](int x) { return x != 0; }), 700);
+
+  a.set(3, 1);
+  EXPECT_EQ(parallel::find_if(policy, a, [](int x) { return x != 0; }), 3);
+}
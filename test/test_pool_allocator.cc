@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "cds_pool_allocator.h"
+#include "cds_vector.h"
+
+using cds::cds_vector;
+using cds::pool_allocator;
+
+struct alignas(64) OverAligned {
+  char data[64];
+};
+
+TEST(TestPoolAllocator, TestAllocateDeallocate) {
+  pool_allocator<int> alloc;
+  int* p = alloc.allocate(1);
+  *p = 42;
+  EXPECT_EQ(*p, 42);
+  alloc.deallocate(p, 1);
+
+  // The most recently freed block is handed out first.
+  int* q = alloc.allocate(1);
+  EXPECT_EQ(p, q);
+  alloc.deallocate(q, 1);
+}
+
+TEST(TestPoolAllocator, TestDistinctBlocks) {
+  pool_allocator<std::uint64_t> alloc;
+  std::vector<std::uint64_t*> blocks;
+  std::set<std::uint64_t*> unique;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    std::uint64_t* p = alloc.allocate(1);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(std::uint64_t), 0);
+    *p = i;
+    blocks.push_back(p);
+    unique.insert(p);
+  }
+  EXPECT_EQ(unique.size(), blocks.size());
+
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_EQ(*blocks[i], i);
+    alloc.deallocate(blocks[i], 1);
+  }
+}
+
+TEST(TestPoolAllocator, TestLargeAndOverAligned) {
+  pool_allocator<char> chars;
+  char* big = chars.allocate(1 << 20);
+  big[0] = 'a';
+  big[(1 << 20) - 1] = 'z';
+  chars.deallocate(big, 1 << 20);
+
+  pool_allocator<OverAligned> aligned;
+  OverAligned* p = aligned.allocate(3);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(OverAligned), 0);
+  aligned.deallocate(p, 3);
+}
+
+TEST(TestPoolAllocator, TestEquality) {
+  pool_allocator<int> a;
+  pool_allocator<double> b(a);
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+}
+
+TEST(TestPoolAllocator, TestWithVector) {
+  using vector = cds_vector<int, pool_allocator<int>>;
+  for (int round = 0; round < 100; ++round) {
+    const std::size_t count = 10;
+    vector a(count, round);
+    EXPECT_EQ(a.size(), 10);
+    EXPECT_EQ(a[9], round);
+
+    vector b = {1, 2, 3, 4, 5};
+    vector c(b);
+    EXPECT_EQ(c.size(), 5);
+    EXPECT_EQ(c[4], 5);
+  }
+}
+
+TEST(TestPoolAllocator, TestCrossThreadFree) {
+  const std::size_t n_threads = 4;
+  const std::size_t n_blocks = 10000;
+  std::vector<std::vector<int*>> blocks(n_threads);
+  pool_allocator<int> alloc;
+
+  std::vector<std::thread> producers;
+  for (std::size_t i = 0; i < n_threads; ++i) {
+    producers.emplace_back([&blocks, &alloc, i]() {
+      for (std::size_t j = 0; j < n_blocks; ++j) {
+        int* p = alloc.allocate(1);
+        *p = static_cast<int>(i);
+        blocks[i].push_back(p);
+      }
+    });
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+
+  // Free every block from a different thread than the one that allocated it.
+  std::vector<std::thread> consumers;
+  for (std::size_t i = 0; i < n_threads; ++i) {
+    consumers.emplace_back([&blocks, &alloc, i, n_threads]() {
+      const std::size_t source = (i + 1) % n_threads;
+      for (int* p : blocks[source]) {
+        EXPECT_EQ(*p, static_cast<int>(source));
+        alloc.deallocate(p, 1);
+      }
+    });
+  }
+  for (std::thread& t : consumers) {
+    t.join();
+  }
+}
+
+TEST(TestPoolAllocator, TestFreeAfterCacheTeardown) {
+  // The container is built before the thread's cache, which it first uses
+  // when it grows, so it is destroyed after the cache and its blocks go
+  // straight to the depot.
+  std::thread([]() {
+    thread_local std::vector<int, pool_allocator<int>> early;
+    early.push_back(1);
+    EXPECT_FALSE(cds::detail::pool_cache_destroyed);
+  }).join();
+
+  std::thread([]() {
+    struct late_user {
+      ~late_user() {
+        EXPECT_TRUE(cds::detail::pool_cache_destroyed);
+        pool_allocator<int> alloc;
+        int* p = alloc.allocate(1);
+        *p = 3;
+        alloc.deallocate(p, 1);
+      }
+    };
+    thread_local late_user user;
+    (void)&user;
+    pool_allocator<int> alloc;
+    alloc.deallocate(alloc.allocate(1), 1);
+  }).join();
+}
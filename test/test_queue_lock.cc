@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_queue_lock.h"
+#include "cds_vector.h"
+
+using cds::clh_lock;
+using cds::mcs_lock;
+
+namespace {
+template <typename Lock>
+void expect_mutual_exclusion() {
+  Lock lock;
+  long value = 0;
+  constexpr int threads = 4;
+  constexpr int iterations = 20000;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&] {
+      for (int i = 0; i < iterations; ++i) {
+        std::lock_guard<Lock> guard(lock);
+        ++value;
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  EXPECT_EQ(value, static_cast<long>(threads) * iterations);
+}
+
+template <typename Lock>
+void expect_fifo_handoff() {
+  // Waiters queue up in a known order while the lock is held, and must be
+  // served in that order.
+  Lock lock;
+  std::vector<int> order;
+  std::atomic<int> queued{0};
+  lock.lock();
+
+  std::vector<std::thread> waiters;
+  for (int t = 0; t < 4; ++t) {
+    waiters.emplace_back([&, t] {
+      while (queued.load() != t) {
+        std::this_thread::yield();
+      }
+      // Give the previous waiter time to enqueue before this one does.
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      queued = t + 1;
+      std::lock_guard<Lock> guard(lock);
+      order.push_back(t);
+    });
+    while (queued.load() != t + 1) {
+      std::this_thread::yield();
+    }
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  lock.unlock();
+  for (auto& w : waiters) {
+    w.join();
+  }
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+}  // namespace
+
+TEST(TestQueueLock, TestMcsMutualExclusion) {
+  expect_mutual_exclusion<mcs_lock>();
+}
+
+TEST(TestQueueLock, TestClhMutualExclusion) {
+  expect_mutual_exclusion<clh_lock>();
+}
+
+TEST(TestQueueLock, TestMcsTryLock) {
+  mcs_lock lock;
+  EXPECT_TRUE(lock.try_lock());
+  std::thread([&] { EXPECT_FALSE(lock.try_lock()); }).join();
+  lock.unlock();
+  {
+    cds::mcs_guard guard(lock);
+  }
+  EXPECT_TRUE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST(TestQueueLock, TestNestedLocks) {
+  // One thread may hold several queue locks at once.
+  mcs_lock a;
+  mcs_lock b;
+  clh_lock c;
+  for (int i = 0; i < 3; ++i) {
+    std::scoped_lock both(a, b);
+    cds::clh_guard guard(c);
+  }
+}
+
+TEST(TestQueueLock, TestFifoHandoff) {
+  expect_fifo_handoff<mcs_lock>();
+  expect_fifo_handoff<clh_lock>();
+}
+
+TEST(TestQueueLock, TestContainers) {
+  using mcs_shared = cds::queued_shared_mutex<mcs_lock>;
+  using clh_shared = cds::queued_shared_mutex<clh_lock>;
+
+  cds::cds_array<int, 4, clh_shared> a{1, 2, 3, 4};
+  cds::cds_array<int, 4, clh_shared> b{5, 6, 7, 8};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        if (t % 2) {
+          a.swap(b);
+        } else {
+          b.swap(a);
+        }
+        EXPECT_FALSE(a == b);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(a.at(0) + b.at(0), 6);
+
+  cds::cds_vector<int, std::allocator<int>, mcs_shared> vec;
+  threads.clear();
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(vec.size(), 4000);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cds_replicated_vector.h"
+
+using cds::cds_replicated_vector;
+
+namespace {
+// Copy construction throws once copies_left reaches zero; -1 disables it.
+struct flaky {
+  static inline int copies_left = -1;
+  int value;
+
+  flaky(const int v) : value(v) {}
+  flaky(const flaky& other) : value(other.value) {
+    if (copies_left == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    if (copies_left > 0) {
+      --copies_left;
+    }
+  }
+  flaky(flaky&&) noexcept = default;
+  flaky& operator=(const flaky&) = default;
+  flaky& operator=(flaky&&) noexcept = default;
+};
+}  // namespace
+
+TEST(TestReplicatedVector, TestDefaultReplicas) {
+  cds_replicated_vector<int> v;
+  EXPECT_EQ(v.replica_count(), cds::numa_topology::instance().node_count());
+}
+
+TEST(TestReplicatedVector, TestWritesAndReads) {
+  cds_replicated_vector<int> v(3);
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.set(1, 20);
+  v.erase(0);
+  EXPECT_EQ(v.size(), 2);
+  EXPECT_EQ(v[0], 20);
+  EXPECT_EQ(v.at(1), 3);
+
+  EXPECT_THROW(v.set(2, 0), std::out_of_range);
+  EXPECT_THROW(v.erase(2), std::out_of_range);
+  EXPECT_THROW(v.at(2), std::out_of_range);
+}
+
+TEST(TestReplicatedVector, TestReplicasApplyLazily) {
+  cds_replicated_vector<int> v(4);
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+
+  // Some replica other than the writer's has not applied anything yet.
+  std::size_t lagging = 0;
+  for (std::size_t r = 0; r < v.replica_count(); ++r) {
+    if (v.replica_lag(r) == 10) {
+      ++lagging;
+    }
+  }
+  EXPECT_GE(lagging, 3);
+
+  for (std::size_t r = 0; r < v.replica_count(); ++r) {
+    auto read = v.new_scoped_read(r);
+    ASSERT_EQ(read.size(), 10);
+    EXPECT_EQ(read[9], 9);
+    EXPECT_EQ(v.replica_lag(r), 0);
+  }
+  EXPECT_THROW(v.new_scoped_read(4), std::out_of_range);
+}
+
+TEST(TestReplicatedVector, TestLogTruncation) {
+  cds_replicated_vector<int> v(2, 8);
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i);
+  }
+  // Writers sync every replica whenever the log exceeds its bound.
+  EXPECT_LE(v.replica_lag(0), 8);
+  EXPECT_LE(v.replica_lag(1), 8);
+
+  v.sync();
+  EXPECT_EQ(v.replica_lag(0), 0);
+  EXPECT_EQ(v.replica_lag(1), 0);
+  auto read = v.new_scoped_read(1);
+  EXPECT_EQ(read[99], 99);
+}
+
+TEST(TestReplicatedVector, TestConcurrentReadersAndWriters) {
+  constexpr int kWriters = 2;
+  constexpr int kPerWriter = 2000;
+  cds_replicated_vector<int> v(4, 64);
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < kWriters; ++w) {
+    threads.emplace_back([&v] {
+      for (int i = 0; i < kPerWriter; ++i) {
+        v.push_back(i);
+      }
+    });
+  }
+  for (std::size_t r = 0; r < v.replica_count(); ++r) {
+    threads.emplace_back([&v, r] {
+      std::size_t last = 0;
+      for (int i = 0; i < 500; ++i) {
+        const std::size_t size = v.new_scoped_read(r).size();
+        EXPECT_GE(size, last);
+        last = size;
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  v.sync();
+  for (std::size_t r = 0; r < v.replica_count(); ++r) {
+    EXPECT_EQ(v.new_scoped_read(r).size(),
+              static_cast<std::size_t>(kWriters * kPerWriter));
+  }
+}
+
+TEST(TestReplicatedVector, TestCatchUpIsExceptionSafe) {
+  cds_replicated_vector<flaky> v(1);
+  v.push_back(1);
+  v.push_back(2);
+
+  // The logged copy succeeds and applying it to the replica fails.
+  flaky::copies_left = 1;
+  EXPECT_THROW(v.push_back(3), std::runtime_error);
+  // Catching up applies 3, then fails on 4; 3 must not be applied twice.
+  flaky::copies_left = 2;
+  EXPECT_THROW(v.push_back(4), std::runtime_error);
+
+  flaky::copies_left = -1;
+  ASSERT_EQ(v.size(), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(v.at(i).value, i + 1);
+  }
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_serialize.h"
+#include "cds_vector.h"
+
+using cds::cds_array;
+using cds::cds_vector;
+using cds::io_slice;
+
+namespace {
+// Collects serialized bytes and records how many writer calls were made.
+struct StringWriter {
+  std::string* out;
+  std::size_t* calls;
+
+  void operator()(const io_slice* slices, const std::size_t count) const {
+    ++*calls;
+    for (std::size_t i = 0; i < count; ++i) {
+      out->append(static_cast<const char*>(slices[i].data), slices[i].size);
+    }
+  }
+};
+
+// Reads back bytes collected by StringWriter.
+struct StringReader {
+  const std::string* in;
+  std::size_t offset = 0;
+
+  void operator()(void* dst, const std::size_t bytes) {
+    if (in->size() - offset < bytes) {
+      throw std::runtime_error("unexpected end of serialized data");
+    }
+    std::memcpy(dst, in->data() + offset, bytes);
+    offset += bytes;
+  }
+};
+}  // namespace
+
+TEST(TestSerialize, TestArrayRoundTrip) {
+  cds_array<std::int32_t, 5> src{1, 2, 3, 4, 5};
+  std::string bytes;
+  std::size_t calls = 0;
+  src.serialize(StringWriter{&bytes, &calls});
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(bytes.size(), sizeof(cds::serial_header) + 5 * sizeof(int));
+
+  cds_array<std::int32_t, 5> dst;
+  dst.deserialize(StringReader{&bytes});
+  EXPECT_TRUE(src == dst);
+}
+
+TEST(TestSerialize, TestArrayRejectsMismatch) {
+  cds_array<std::int32_t, 5> src{1, 2, 3, 4, 5};
+  std::string bytes;
+  std::size_t calls = 0;
+  src.serialize(StringWriter{&bytes, &calls});
+
+  cds_array<std::int32_t, 4> shorter;
+  EXPECT_THROW(shorter.deserialize(StringReader{&bytes}), std::length_error);
+  cds_array<std::int64_t, 5> wider;
+  EXPECT_THROW(wider.deserialize(StringReader{&bytes}), std::runtime_error);
+
+  std::string garbage(64, 'x');
+  cds_array<std::int32_t, 5> dst;
+  EXPECT_THROW(dst.deserialize(StringReader{&garbage}), std::runtime_error);
+}
+
+TEST(TestSerialize, TestArrayShortReadLeavesArrayUnchanged) {
+  cds_array<std::int32_t, 5> src{1, 2, 3, 4, 5};
+  std::string bytes;
+  std::size_t calls = 0;
+  src.serialize(StringWriter{&bytes, &calls});
+  bytes.resize(bytes.size() - sizeof(std::int32_t));
+
+  // Copies whatever is left before failing, like a short read would.
+  StringReader string_reader{&bytes};
+  auto short_reader = [&](void* dst, const std::size_t n) {
+    if (bytes.size() - string_reader.offset < n) {
+      std::memcpy(dst, bytes.data() + string_reader.offset,
+                  bytes.size() - string_reader.offset);
+    }
+    string_reader(dst, n);
+  };
+
+  cds_array<std::int32_t, 5> dst{9, 9, 9, 9, 9};
+  const auto version = dst.version();
+  EXPECT_THROW(dst.deserialize(short_reader), std::runtime_error);
+  EXPECT_EQ(dst.count(9), 5);
+  EXPECT_EQ(dst.version(), version);
+}
+
+TEST(TestSerialize, TestVectorChunks) {
+  const std::size_t count = 1000;
+  cds_vector<double> src(count, 1.5);
+  {
+    auto write = src.new_scoped_write();
+    write[999] = -2.0;
+  }
+
+  std::string bytes;
+  std::size_t calls = 0;
+  src.serialize_chunks(StringWriter{&bytes, &calls}, 3000);
+  // One header call plus ceil(8000 / 3000) element chunks.
+  EXPECT_EQ(calls, 4);
+  EXPECT_THROW(src.serialize_chunks(StringWriter{&bytes, &calls}, 0),
+               std::invalid_argument);
+
+  cds_vector<double> dst{7.0};
+  dst.deserialize(StringReader{&bytes});
+  ASSERT_EQ(dst.size(), count);
+  EXPECT_EQ(dst[0], 1.5);
+  EXPECT_EQ(dst[999], -2.0);
+}
+
+TEST(TestSerialize, TestEmptyVector) {
+  cds_vector<int> src;
+  std::string bytes;
+  std::size_t calls = 0;
+  src.serialize(StringWriter{&bytes, &calls});
+  EXPECT_EQ(bytes.size(), sizeof(cds::serial_header));
+
+  cds_vector<int> dst{1, 2, 3};
+  dst.deserialize(StringReader{&bytes});
+  EXPECT_TRUE(dst.empty());
+}
+
+TEST(TestSerialize, TestFileDescriptors) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+
+  const std::size_t count = 100;
+  cds_vector<std::int64_t> src(count, 42);
+  src.serialize(cds::fd_writer{fds[1]});
+  ::close(fds[1]);
+
+  cds_vector<std::int64_t> dst;
+  dst.deserialize(cds::fd_reader{fds[0]});
+  ::close(fds[0]);
+  ASSERT_EQ(dst.size(), count);
+  EXPECT_EQ(dst[count - 1], 42);
+}
@@ -0,0 +1,128 @@
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "cds_shared_array.h"
+
+using cds::cds_shared_array;
+using cds::shm_object;
+
+namespace {
+using SharedTable = cds_shared_array<int, 64>;
+
+std::string unique_name(const char* tag) {
+  return "/cds-test-" + std::string(tag) + "-" + std::to_string(::getpid());
+}
+}  // namespace
+
+TEST(TestSharedArray, TestLocalAccess) {
+  SharedTable arr;
+  EXPECT_EQ(arr.size(), 64);
+  EXPECT_EQ(arr[0], 0);
+
+  arr.set(3, 7);
+  EXPECT_EQ(arr.at(3), 7);
+  EXPECT_THROW(arr.at(64), std::out_of_range);
+  EXPECT_THROW(arr.set(64, 1), std::out_of_range);
+
+  arr.fill(2);
+  int out[4] = {};
+  arr.copy_out(60, 4, out);
+  EXPECT_EQ(out[0], 2);
+  EXPECT_EQ(out[3], 2);
+  EXPECT_THROW(arr.copy_out(61, 4, out), std::out_of_range);
+
+  {
+    auto write = arr.new_scoped_write();
+    write[0] = 1;
+    write[63] = 9;
+  }
+  auto read = arr.new_scoped_read();
+  EXPECT_EQ(read[0], 1);
+  EXPECT_EQ(read[63], 9);
+}
+
+TEST(TestSharedArray, TestCreateAndOpen) {
+  const std::string name = unique_name("open");
+  auto owner = shm_object<SharedTable>::create(name);
+  EXPECT_THROW(shm_object<SharedTable>::create(name), std::system_error);
+
+  owner->set(5, 55);
+  {
+    // A second mapping of the same object sees the same elements.
+    auto view = shm_object<SharedTable>::open(name);
+    EXPECT_NE(&*view, &*owner);
+    EXPECT_EQ(view->at(5), 55);
+    view->set(6, 66);
+  }
+  EXPECT_EQ(owner->at(6), 66);
+}
+
+TEST(TestSharedArray, TestOpenMissing) {
+  EXPECT_THROW(shm_object<SharedTable>::open(unique_name("missing")),
+               std::system_error);
+}
+
+TEST(TestSharedArray, TestOpenTimesOut) {
+  using namespace std::chrono_literals;
+  const std::string name = unique_name("timeout");
+
+  // A creator that died right after shm_open: the object is never sized.
+  const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  ASSERT_GE(fd, 0);
+  EXPECT_THROW(shm_object<SharedTable>::open(name, 20ms), std::runtime_error);
+
+  // A creator that died after sizing the object: it is never constructed.
+  ASSERT_EQ(::ftruncate(fd, static_cast<off_t>(sizeof(SharedTable) + 4096)),
+            0);
+  EXPECT_THROW(shm_object<SharedTable>::open(name, 20ms), std::runtime_error);
+
+  ::close(fd);
+  ::shm_unlink(name.c_str());
+}
+
+TEST(TestSharedArray, TestCrossProcess) {
+  const std::string name = unique_name("fork");
+  auto owner = shm_object<SharedTable>::create(name);
+
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    int status = 1;
+    try {
+      auto view = shm_object<SharedTable>::open(name);
+      for (int i = 0; i < 1000; ++i) {
+        auto write = view->new_scoped_write();
+        for (std::size_t pos = 0; pos < view->size(); ++pos) {
+          ++write[pos];
+        }
+      }
+      status = 0;
+    } catch (...) {
+    }
+    ::_exit(status);
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    auto write = owner->new_scoped_write();
+    for (std::size_t pos = 0; pos < owner->size(); ++pos) {
+      ++write[pos];
+    }
+  }
+
+  int status = 0;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  for (std::size_t pos = 0; pos < owner->size(); ++pos) {
+    EXPECT_EQ(owner->at(pos), 2000);
+  }
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "cds_simd.h"
+
+using cds::simd_level;
+using cds::detail::active_simd_level;
+using cds::detail::simd_scan;
+
+namespace {
+std::vector<simd_level> supported_levels() {
+  std::vector<simd_level> levels;
+  for (const simd_level level : {simd_level::scalar, simd_level::sse2,
+                                 simd_level::avx2, simd_level::avx512}) {
+    if (level <= active_simd_level()) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+// Checks find and count for every level, buffer length and match position
+// (covering full vectors and scalar tails).
+template <typename T>
+void check_scan(const T zero, const T needle) {
+  for (const simd_level level : supported_levels()) {
+    for (std::size_t n = 0; n <= 150; n += 7) {
+      std::vector<T> data(n, zero);
+      EXPECT_EQ(simd_scan<false>(level, data.data(), n, needle), n);
+      EXPECT_EQ(simd_scan<true>(level, data.data(), n, needle), 0);
+
+      // Plant matches from the back so each new one becomes the first.
+      std::size_t planted = 0;
+      for (std::size_t pos = n; pos-- > 0; pos -= pos >= 4 ? 4 : pos) {
+        data[pos] = needle;
+        ++planted;
+        EXPECT_EQ(simd_scan<false>(level, data.data(), n, needle), pos);
+        EXPECT_EQ(simd_scan<true>(level, data.data(), n, needle), planted);
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(TestSimd, TestScanIntegers) {
+  check_scan<std::int8_t>(0, -1);
+  check_scan<std::uint8_t>(1, 255);
+  check_scan<std::int16_t>(0, -300);
+  check_scan<std::uint16_t>(0, 0xffff);
+  check_scan<std::int32_t>(0, -7);
+  check_scan<std::uint32_t>(0, 0x80000000u);
+  check_scan<std::int64_t>(0, -1);
+  check_scan<std::uint64_t>(0, 0x100000000ull);
+}
+
+TEST(TestSimd, TestScanFloatingPoint) {
+  check_scan<float>(0.0f, 1.5f);
+  check_scan<double>(0.0, -2.25);
+
+  // Floating point semantics: -0.0 == 0.0 and NaN never matches.
+  const std::vector<double> data = {1.0, -0.0, 3.0, 4.0, 5.0};
+  const std::vector<float> nans(40, std::numeric_limits<float>::quiet_NaN());
+  for (const simd_level level : supported_levels()) {
+    EXPECT_EQ(simd_scan<false>(level, data.data(), data.size(), 0.0), 1);
+    EXPECT_EQ(simd_scan<true>(level, nans.data(), nans.size(), nans[0]), 0);
+  }
+}
+
+TEST(TestSimd, TestWideCompareUsesBothHalves) {
+  // 64-bit compares must require both 32-bit halves to match.
+  const std::vector<std::uint64_t> data(8, 0x0000000100000002ull);
+  for (const simd_level level : supported_levels()) {
+    EXPECT_EQ(
+        simd_scan<true>(level, data.data(), data.size(), std::uint64_t(2)), 0);
+    EXPECT_EQ(simd_scan<true>(level, data.data(), data.size(),
+                              std::uint64_t(0x0000000200000002ull)),
+              0);
+  }
+}
+
+TEST(TestSimd, TestEqual) {
+  std::vector<int> a(100, 1);
+  std::vector<int> b(100, 1);
+  EXPECT_TRUE(cds::detail::simd_equal(a.data(), b.data(), a.size()));
+  b[99] = 2;
+  EXPECT_FALSE(cds::detail::simd_equal(a.data(), b.data(), a.size()));
+
+  const double x[2] = {0.0, 1.0};
+  const double y[2] = {-0.0, 1.0};
+  EXPECT_TRUE(cds::detail::simd_equal(x, y, 2));
+}
+
+TEST(TestSimd, TestSwapRanges) {
+  for (const simd_level level : supported_levels()) {
+    for (std::size_t n = 0; n <= 150; n += 7) {
+      std::vector<std::uint16_t> a(n);
+      std::vector<std::uint16_t> b(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<std::uint16_t>(i);
+        b[i] = static_cast<std::uint16_t>(1000 + i);
+      }
+      cds::detail::simd_swap_ranges(level, a.data(), b.data(), n);
+      for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(a[i], 1000 + i);
+        EXPECT_EQ(b[i], i);
+      }
+    }
+  }
+}
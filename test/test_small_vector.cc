@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cds_small_vector.h"
+
+using cds::cds_small_vector;
+
+namespace {
+// Counts outstanding heap allocations.
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+  static inline long live = 0;
+
+  counting_allocator() = default;
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&) noexcept {}
+
+  T* allocate(const std::size_t n) {
+    ++live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, const std::size_t n) noexcept {
+    --live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  friend bool operator==(const counting_allocator&,
+                         const counting_allocator&) {
+    return true;
+  }
+  friend bool operator!=(const counting_allocator&,
+                         const counting_allocator&) {
+    return false;
+  }
+};
+
+// Copy construction throws once copies_left reaches zero.
+struct throwing_copy {
+  static inline int copies_left = 0;
+
+  throwing_copy() = default;
+  throwing_copy(const throwing_copy&) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+};
+}  // namespace
+
+TEST(TestSmallVector, TestInlineStorage) {
+  cds_small_vector<int, 4> v;
+  EXPECT_TRUE(v.empty());
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 4);
+
+  for (int i = 0; i < 4; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.size(), 4);
+
+  v.push_back(4);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 8);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(v[i], i);
+  }
+}
+
+TEST(TestSmallVector, TestConstructors) {
+  cds_small_vector<std::string, 2> filled(3, "x");
+  EXPECT_EQ(filled.size(), 3);
+  EXPECT_FALSE(filled.is_inline());
+  EXPECT_EQ(filled[2], "x");
+
+  cds_small_vector<std::string, 2> list{"a", "b"};
+  EXPECT_TRUE(list.is_inline());
+  EXPECT_EQ(list[1], "b");
+
+  cds_small_vector<std::string, 2> copy(filled);
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy[0], "x");
+
+  cds_small_vector<std::string, 2> moved_inline(std::move(list));
+  EXPECT_EQ(moved_inline.size(), 2);
+  EXPECT_EQ(moved_inline[0], "a");
+  EXPECT_TRUE(list.empty());
+
+  cds_small_vector<std::string, 2> moved_heap(std::move(filled));
+  EXPECT_EQ(moved_heap.size(), 3);
+  EXPECT_TRUE(filled.empty());
+  EXPECT_TRUE(filled.is_inline());
+  filled.push_back("reused");
+  EXPECT_EQ(filled[0], "reused");
+}
+
+TEST(TestSmallVector, TestThrowingConstructorsReleaseStorage) {
+  using vector_type =
+      cds_small_vector<throwing_copy, 2, counting_allocator<throwing_copy>>;
+  const throwing_copy value;
+
+  throwing_copy::copies_left = 3;
+  EXPECT_THROW(vector_type(5, value), std::runtime_error);
+  EXPECT_EQ(counting_allocator<throwing_copy>::live, 0);
+
+  // Building the list itself takes five copies.
+  throwing_copy::copies_left = 5 + 3;
+  EXPECT_THROW((vector_type{value, value, value, value, value}),
+               std::runtime_error);
+  EXPECT_EQ(counting_allocator<throwing_copy>::live, 0);
+
+  throwing_copy::copies_left = 5;
+  vector_type v(5, value);
+  throwing_copy::copies_left = 3;
+  EXPECT_THROW(vector_type{v}, std::runtime_error);
+  EXPECT_EQ(counting_allocator<throwing_copy>::live, 1);
+}
+
+TEST(TestSmallVector, TestSetErase) {
+  cds_small_vector<int, 8> v{1, 2, 3};
+  v.set(0, 10);
+  EXPECT_EQ(v[0], 10);
+  EXPECT_THROW(v.set(3, 0), std::out_of_range);
+
+  v.erase(1);
+  EXPECT_EQ(v.size(), 2);
+  EXPECT_EQ(v[1], 3);
+  EXPECT_THROW(v.erase(2), std::out_of_range);
+
+  v.reserve(100);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v[0], 10);
+}
+
+TEST(TestSmallVector, TestScopedAccess) {
+  cds_small_vector<std::unique_ptr<int>, 2> v;
+  {
+    auto write = v.new_scoped_write();
+    write.push_back(std::make_unique<int>(1));
+    write.push_back(std::make_unique<int>(2));
+    write.push_back(std::make_unique<int>(3));
+    *write.front() = 10;
+    write.erase(1);
+    EXPECT_EQ(write.size(), 2);
+  }
+
+  auto read = v.new_scoped_read();
+  EXPECT_EQ(*read.front(), 10);
+  EXPECT_EQ(*read.back(), 3);
+  EXPECT_THROW(read.at(2), std::out_of_range);
+}
+
+TEST(TestSmallVector, TestConcurrentPushBack) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 1000;
+  cds_small_vector<int, 8> v;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&v] {
+      for (int i = 0; i < kPerThread; ++i) {
+        v.push_back(i);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(v.size(), static_cast<std::size_t>(kThreads * kPerThread));
+}
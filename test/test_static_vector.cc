@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cds_static_vector.h"
+
+using cds::cds_static_vector;
+
+namespace {
+struct ThrowOnNegative {
+  explicit ThrowOnNegative(const int v) : value(v) {
+    if (v < 0) {
+      throw std::invalid_argument("negative");
+    }
+  }
+  int value;
+};
+}  // namespace
+
+TEST(TestStaticVector, TestAppend) {
+  cds_static_vector<std::string, 3> v;
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 3);
+
+  EXPECT_TRUE(v.try_push_back("a"));
+  std::string b = "b";
+  EXPECT_TRUE(v.try_push_back(std::move(b)));
+  EXPECT_TRUE(v.try_emplace_back(2, 'c'));
+  EXPECT_TRUE(v.full());
+  EXPECT_FALSE(v.try_push_back("d"));
+  EXPECT_EQ(v.size(), 3);
+
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "b");
+  EXPECT_EQ(v.at(2), "cc");
+  EXPECT_THROW(v.at(3), std::out_of_range);
+}
+
+TEST(TestStaticVector, TestClear) {
+  cds_static_vector<std::shared_ptr<int>, 2> v;
+  auto shared = std::make_shared<int>(1);
+  v.try_push_back(shared);
+  v.try_push_back(shared);
+  EXPECT_EQ(shared.use_count(), 3);
+
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(shared.use_count(), 1);
+  EXPECT_FALSE(v.is_ready(0));
+  EXPECT_TRUE(v.try_push_back(shared));
+  EXPECT_TRUE(v.is_ready(0));
+}
+
+TEST(TestStaticVector, TestFailedConstruction) {
+  cds_static_vector<ThrowOnNegative, 4> v;
+  EXPECT_TRUE(v.try_emplace_back(1));
+  EXPECT_THROW(v.try_emplace_back(-1), std::invalid_argument);
+  EXPECT_TRUE(v.try_emplace_back(3));
+
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_FALSE(v.is_ready(1));
+  EXPECT_THROW(v.at(1), std::out_of_range);
+
+  int sum = 0;
+  v.for_each_ready([&](std::size_t, const ThrowOnNegative& e) {
+    sum += e.value;
+  });
+  EXPECT_EQ(sum, 4);
+}
+
+TEST(TestStaticVector, TestConcurrentAppend) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 1000;
+  constexpr std::size_t kCapacity = 4096;
+  cds_static_vector<std::pair<int, int>, kCapacity> v;
+  std::atomic<int> accepted(0);
+  std::atomic<bool> done(false);
+  std::atomic<bool> torn(false);
+
+  // A lock-free reader only ever sees fully constructed elements.
+  std::thread reader([&] {
+    while (!done.load()) {
+      v.for_each_ready([&](std::size_t, const std::pair<int, int>& e) {
+        if (e.first != -e.second) {
+          torn = true;
+        }
+      });
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        const int value = t * kPerThread + i;
+        if (v.try_emplace_back(value, -value)) {
+          ++accepted;
+        }
+      }
+    });
+  }
+  for (std::thread& t : writers) {
+    t.join();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_FALSE(torn.load());
+  EXPECT_EQ(accepted.load(), static_cast<int>(kCapacity));
+  EXPECT_TRUE(v.full());
+  std::vector<bool> seen(kThreads * kPerThread);
+  v.for_each_ready([&](std::size_t, const std::pair<int, int>& e) {
+    EXPECT_FALSE(seen[e.first]);
+    seen[e.first] = true;
+  });
+}
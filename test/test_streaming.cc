@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "cds_array.h"
+#include "cds_streaming.h"
+#include "cds_vector.h"
+
+using cds::cds_array;
+using cds::cds_vector;
+
+namespace {
+// Forces every fill and copy through the streaming path for one test.
+class StreamingThresholdGuard {
+ public:
+  explicit StreamingThresholdGuard(const std::size_t bytes)
+      : previous_(cds::streaming_threshold()) {
+    cds::set_streaming_threshold(bytes);
+  }
+  ~StreamingThresholdGuard() { cds::set_streaming_threshold(previous_); }
+
+ private:
+  std::size_t previous_;
+};
+
+struct Pair {
+  std::uint32_t a;
+  std::uint32_t b;
+};
+}  // namespace
+
+TEST(TestStreaming, TestThreshold) {
+  EXPECT_EQ(cds::streaming_threshold(), cds::default_streaming_threshold);
+  {
+    StreamingThresholdGuard guard(123);
+    EXPECT_EQ(cds::streaming_threshold(), 123);
+  }
+  EXPECT_EQ(cds::streaming_threshold(), cds::default_streaming_threshold);
+}
+
+TEST(TestStreaming, TestBulkFillOffsets) {
+  StreamingThresholdGuard guard(0);
+  std::vector<std::uint16_t> buffer(300, 0);
+  // Every start offset and length exercises the head, body and tail.
+  for (std::size_t offset = 0; offset < 17; ++offset) {
+    for (std::size_t n = 0; n < 200; n += 13) {
+      std::fill(buffer.begin(), buffer.end(), 0);
+      cds::detail::bulk_fill(buffer.data() + offset, n, std::uint16_t(0xbeef));
+      for (std::size_t i = 0; i < buffer.size(); ++i) {
+        const bool inside = i >= offset && i < offset + n;
+        EXPECT_EQ(buffer[i], inside ? 0xbeef : 0);
+      }
+    }
+  }
+
+  std::vector<Pair> pairs(100);
+  cds::detail::bulk_fill(pairs.data(), pairs.size(), Pair{1, 2});
+  for (const Pair& p : pairs) {
+    EXPECT_EQ(p.a, 1);
+    EXPECT_EQ(p.b, 2);
+  }
+}
+
+TEST(TestStreaming, TestBulkCopyOffsets) {
+  StreamingThresholdGuard guard(0);
+  std::vector<std::uint8_t> src(300);
+  std::iota(src.begin(), src.end(), 0);
+  for (std::size_t offset = 0; offset < 33; ++offset) {
+    for (std::size_t n = 0; n < 250; n += 11) {
+      std::vector<std::uint8_t> dst(300, 0);
+      cds::detail::bulk_copy(src.data() + 1, n, dst.data() + offset);
+      for (std::size_t i = 0; i < dst.size(); ++i) {
+        const bool inside = i >= offset && i < offset + n;
+        EXPECT_EQ(dst[i], inside ? src[i - offset + 1] : 0);
+      }
+    }
+  }
+}
+
+TEST(TestStreaming, TestArray) {
+  StreamingThresholdGuard guard(0);
+  cds_array<int, 1000> a{};
+  a.fill(7);
+  EXPECT_EQ(a.count(7), 1000);
+
+  cds_array<int, 1000> b(a);
+  EXPECT_TRUE(a == b);
+
+  a.set(999, 1);
+  b = a;
+  EXPECT_EQ(b[999], 1);
+  EXPECT_EQ(b[0], 7);
+}
+
+TEST(TestStreaming, TestVector) {
+  StreamingThresholdGuard guard(0);
+  const std::size_t count = 1001;
+  cds_vector<double> a(count, 2.5);
+  EXPECT_EQ(a[0], 2.5);
+  EXPECT_EQ(a[count - 1], 2.5);
+
+  cds_vector<double> b(a);
+  EXPECT_EQ(b.size(), count);
+  EXPECT_EQ(b[count / 2], 2.5);
+
+  cds_vector<double> empty(0, 1.0);
+  cds_vector<double> empty_copy(empty);
+  EXPECT_TRUE(empty_copy.empty());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "cds_parallel.h"
+#include "cds_thread_pool.h"
+#include "cds_vector.h"
+
+using cds::cds_vector;
+using cds::task_future;
+using cds::thread_pool;
+using cds::thread_pool_options;
+
+TEST(TestThreadPool, TestSubmit) {
+  thread_pool_options options;
+  options.threads = 4;
+  thread_pool pool(options);
+  EXPECT_EQ(pool.size(), 4);
+
+  std::vector<task_future<int>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.submit([i]() { return i * i; }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(futures[i].get(), i * i);
+  }
+
+  std::atomic<int> counter(0);
+  task_future<void> done = pool.submit([&counter]() { ++counter; });
+  done.wait();
+  EXPECT_TRUE(done.ready());
+  EXPECT_EQ(counter, 1);
+}
+
+TEST(TestThreadPool, TestSubmitException) {
+  thread_pool pool;
+  task_future<int> f =
+      pool.submit([]() -> int { throw std::runtime_error("task"); });
+  EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(TestThreadPool, TestNestedSubmit) {
+  thread_pool_options options;
+  options.threads = 2;
+  thread_pool pool(options);
+
+  // Waiting inside a task runs other tasks instead of blocking the worker.
+  task_future<int> outer = pool.submit([&pool]() {
+    std::vector<task_future<int>> inner;
+    for (int i = 0; i < 50; ++i) {
+      inner.push_back(pool.submit([i]() { return i; }));
+    }
+    int sum = 0;
+    for (auto& f : inner) {
+      sum += f.get();
+    }
+    return sum;
+  });
+  EXPECT_EQ(outer.get(), 49 * 50 / 2);
+}
+
+TEST(TestThreadPool, TestParallelFor) {
+  thread_pool pool;
+  std::vector<std::atomic<int>> hits(10007);
+  pool.parallel_for(0, hits.size(), 100,
+                    [&hits](const std::size_t b, const std::size_t e) {
+                      for (std::size_t i = b; i < e; ++i) {
+                        ++hits[i];
+                      }
+                    });
+  for (const auto& hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+
+  EXPECT_THROW(pool.parallel_for(0, 1000, 10,
+                                 [](std::size_t b, std::size_t) {
+                                   if (b == 500) {
+                                     throw std::runtime_error("chunk");
+                                   }
+                                 }),
+               std::runtime_error);
+}
+
+TEST(TestThreadPool, TestNestedParallelFor) {
+  thread_pool_options options;
+  options.threads = 3;
+  thread_pool pool(options);
+  std::atomic<int> total(0);
+  pool.submit([&pool, &total]() {
+        pool.parallel_for(0, 100, 1, [&total](std::size_t b, std::size_t e) {
+          total += static_cast<int>(e - b);
+        });
+      })
+      .get();
+  EXPECT_EQ(total, 100);
+}
+
+TEST(TestThreadPool, TestPinnedAndGrouped) {
+  thread_pool_options options;
+  options.threads = 4;
+  options.pin_threads = true;
+  options.group_by_node = true;
+  thread_pool pool(options);
+
+  std::vector<task_future<int>> futures;
+  for (int i = 0; i < 20; ++i) {
+    futures.push_back(pool.submit([i]() { return i; }));
+  }
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(futures[i].get(), i);
+  }
+}
+
+TEST(TestThreadPool, TestParallelAlgorithms) {
+  thread_pool pool;
+  const std::size_t count = 100000;
+  cds_vector<long> v(count, 1);
+  cds::parallel::for_each(pool, v, [](long& x) { x *= 3; });
+  EXPECT_EQ(cds::parallel::reduce(pool, v, 0L), 3 * static_cast<long>(count));
+
+  {
+    auto write = v.new_scoped_write();
+    std::iota(v.begin(), v.end(), 0L);
+  }
+  cds::parallel::sort(pool, v, std::greater<>());
+  EXPECT_EQ(v[0], static_cast<long>(count - 1));
+  EXPECT_EQ(v[count - 1], 0);
+  EXPECT_EQ(cds::parallel::find_if(pool, v, [](long x) { return x < 10; }),
+            count - 10);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "cds_triple_buffer.h"
+
+using cds::triple_buffer;
+
+TEST(TestTripleBuffer, TestConstruct) {
+  triple_buffer<int> empty;
+  EXPECT_EQ(empty.read(), 0);
+  EXPECT_FALSE(empty.has_update());
+
+  triple_buffer<int> initial(42);
+  EXPECT_EQ(initial.read(), 42);
+  EXPECT_EQ(initial.write_buffer(), 42);
+}
+
+TEST(TestTripleBuffer, TestPublishAndUpdate) {
+  triple_buffer<int> buffer;
+  buffer.write_buffer() = 1;
+  EXPECT_EQ(buffer.read(), 0);
+
+  buffer.publish();
+  EXPECT_TRUE(buffer.has_update());
+  EXPECT_EQ(buffer.read(), 0);
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.read(), 1);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.read(), 1);
+}
+
+TEST(TestTripleBuffer, TestReaderSeesLatest) {
+  triple_buffer<int> buffer;
+  buffer.write(1);
+  buffer.write(2);
+  buffer.write(3);
+  EXPECT_EQ(buffer.read_latest(), 3);
+  EXPECT_FALSE(buffer.has_update());
+  EXPECT_EQ(buffer.read_latest(), 3);
+}
+
+TEST(TestTripleBuffer, TestArrayPayload) {
+  triple_buffer<std::array<float, 4>> buffer;
+  auto& frame = buffer.write_buffer();
+  frame = {1.0f, 2.0f, 3.0f, 4.0f};
+  buffer.publish();
+
+  const auto& latest = buffer.read_latest();
+  EXPECT_EQ(latest[0], 1.0f);
+  EXPECT_EQ(latest[3], 4.0f);
+}
+
+TEST(TestTripleBuffer, TestConcurrentFrames) {
+  // Every frame holds a single value in all slots and values only grow, so
+  // a torn or stale read shows up as a mixed or decreasing frame.
+  constexpr int kFrames = 20000;
+  triple_buffer<std::array<int, 64>> buffer;
+  std::atomic<bool> torn(false);
+
+  std::thread reader([&] {
+    int last = 0;
+    while (last != kFrames) {
+      const auto& frame = buffer.read_latest();
+      for (const int value : frame) {
+        if (value != frame[0]) {
+          torn = true;
+        }
+      }
+      if (frame[0] < last) {
+        torn = true;
+      }
+      last = frame[0];
+    }
+  });
+
+  for (int frame = 1; frame <= kFrames; ++frame) {
+    buffer.write_buffer().fill(frame);
+    buffer.publish();
+  }
+  reader.join();
+
+  EXPECT_FALSE(torn.load());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cds_update_notifier.h"
+
+using cds::update_notifier;
+
+TEST(TestUpdateNotifier, TestVersion) {
+  update_notifier notifier;
+  EXPECT_EQ(notifier.version(), 0);
+  notifier.notify();
+  notifier.notify();
+  EXPECT_EQ(notifier.version(), 2);
+}
+
+TEST(TestUpdateNotifier, TestAdvanceThenWake) {
+  update_notifier notifier;
+  std::thread waiter([&] { EXPECT_EQ(notifier.wait(0), 1); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(notifier.advance(), 1);
+  notifier.wake();
+  waiter.join();
+}
+
+TEST(TestUpdateNotifier, TestNotOverAligned) {
+  // Embedded in every cds_array and cds_vector, so it must not pad them out
+  // to a cache line.
+  EXPECT_EQ(alignof(update_notifier), alignof(update_notifier::version_type));
+}
+
+TEST(TestUpdateNotifier, TestWaitReturnsImmediatelyWhenStale) {
+  update_notifier notifier;
+  notifier.notify();
+  EXPECT_EQ(notifier.wait(0), 1);
+  EXPECT_EQ(notifier.wait_for(0, std::chrono::seconds(10)), 1);
+}
+
+TEST(TestUpdateNotifier, TestWaitTimesOut) {
+  update_notifier notifier;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(notifier.wait_for(0, std::chrono::milliseconds(20)), 0);
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+}
+
+TEST(TestUpdateNotifier, TestWakesParkedWaiters) {
+  update_notifier notifier;
+  std::atomic<int> woken(0);
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.emplace_back([&] {
+      if (notifier.wait(0) == 1) {
+        ++woken;
+      }
+    });
+  }
+
+  // Give the waiters time to get past spinning and park.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  notifier.notify();
+  for (std::thread& t : waiters) {
+    t.join();
+  }
+  EXPECT_EQ(woken.load(), 4);
+}
+
+TEST(TestUpdateNotifier, TestNoLostWakeups) {
+  constexpr int kUpdates = 10000;
+  update_notifier notifier;
+  std::thread consumer([&] {
+    update_notifier::version_type seen = 0;
+    while (seen != kUpdates) {
+      seen = notifier.wait(seen);
+    }
+  });
+
+  for (int i = 0; i < kUpdates; ++i) {
+    notifier.notify();
+  }
+  consumer.join();
+  EXPECT_EQ(notifier.version(), kUpdates);
+}
@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <iostream>
 #include <memory>
 #include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -196,3 +201,172 @@ TEST(TestVector, TestInitListConstructor) {
   EXPECT_TRUE(b.empty());
   EXPECT_EQ(b.capacity(), 0);
 }
+
+TEST(TestVector, TestScopedWrite) {
+  cds_vector<int> a = {1, 2, 3};
+  {
+    auto scoped_write = a.new_scoped_write();
+    EXPECT_EQ(scoped_write.size(), 3);
+    scoped_write[0] = 4;
+    scoped_write.at(1) = 5;
+    scoped_write.back() = 6;
+    EXPECT_THROW(scoped_write[3] = 7, std::out_of_range);
+  }
+
+  EXPECT_EQ(a[0], 4);
+  EXPECT_EQ(a[1], 5);
+  EXPECT_EQ(a[2], 6);
+}
+
+TEST(TestVector, TestScopedRead) {
+  cds_vector<int> a = {1, 2, 3};
+  auto scoped_read = a.new_scoped_read();
+  EXPECT_EQ(scoped_read.size(), 3);
+  EXPECT_EQ(scoped_read.front(), 1);
+  EXPECT_EQ(scoped_read.at(1), 2);
+  EXPECT_EQ(scoped_read[2], 3);
+  EXPECT_EQ(scoped_read.back(), 3);
+  EXPECT_THROW(scoped_read.at(3), std::out_of_range);
+}
+
+TEST(TestVector, TestWaitForUpdate) {
+  cds_vector<int> v{1, 2, 3};
+  const auto seen = v.version();
+  EXPECT_EQ(v.wait_for_update(seen, std::chrono::milliseconds(1)), seen);
+
+  std::thread writer([&] {
+    auto write = v.new_scoped_write();
+    write[0] = 10;
+  });
+  EXPECT_NE(v.wait_for_update(seen), seen);
+  writer.join();
+  EXPECT_EQ(v[0], 10);
+}
+
+TEST(TestVector, TestPushBack) {
+  cds_vector<std::string> v;
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_GE(v.capacity(), 100);
+  EXPECT_EQ(v[0], "0");
+  EXPECT_EQ(v[99], "99");
+
+  std::string moved = "moved";
+  v.push_back(std::move(moved));
+  EXPECT_EQ(v[100], "moved");
+}
+
+TEST(TestVector, TestSetErase) {
+  cds_vector<int> v{1, 2, 3, 4};
+  v.set(1, 20);
+  EXPECT_EQ(v[1], 20);
+  EXPECT_THROW(v.set(4, 0), std::out_of_range);
+
+  v.erase(0);
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_EQ(v[0], 20);
+  EXPECT_EQ(v[2], 4);
+  EXPECT_THROW(v.erase(3), std::out_of_range);
+
+  v.reserve(50);
+  EXPECT_GE(v.capacity(), 50);
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_EQ(v[1], 3);
+}
+
+TEST(TestVector, TestScopedWritePushBackErase) {
+  cds_vector<int> v;
+  {
+    auto write = v.new_scoped_write();
+    for (int i = 0; i < 8; ++i) {
+      write.push_back(i);
+    }
+    write.erase(0);
+    EXPECT_EQ(write.size(), 7);
+    write.push_back(8);
+  }
+  ASSERT_EQ(v.size(), 8);
+  ASSERT_EQ(v.capacity(), 8);
+  {
+    // Appending an element of the vector itself survives reallocation.
+    auto write = v.new_scoped_write();
+    write.push_back(write[0]);
+    EXPECT_EQ(write.size(), 9);
+  }
+  EXPECT_GT(v.capacity(), 8);
+  EXPECT_EQ(v[0], 1);
+  EXPECT_EQ(v[7], 8);
+  EXPECT_EQ(v[8], 1);
+}
+
+TEST(TestVector, TestRangeSession) {
+  cds_vector<int> v(std::size_t{100}, 0);
+  const auto version = v.version();
+  {
+    auto session = v.new_range_session();
+    auto low = session.lock_range(0, 50);
+    EXPECT_EQ(low.size(), 50);
+    EXPECT_THROW(session.lock_range(50, 101), std::out_of_range);
+    EXPECT_THROW(low.at(50), std::out_of_range);
+
+    // Overlapping claims are refused; adjacent and empty ones are not.
+    EXPECT_FALSE(session.try_lock_range(49, 60));
+    EXPECT_FALSE(session.try_lock_range(10, 20));
+    EXPECT_TRUE(session.try_lock_range(20, 20));
+    auto high = session.try_lock_range(50, 100);
+    ASSERT_TRUE(high);
+    EXPECT_EQ(high->first(), 50);
+
+    low[0] = 1;
+    (*high)[49] = 2;
+    high.reset();
+    EXPECT_TRUE(session.try_lock_range(60, 70));
+  }
+  EXPECT_EQ(v[0], 1);
+  EXPECT_EQ(v[99], 2);
+  EXPECT_NE(v.version(), version);
+}
+
+TEST(TestVector, TestRangeSessionParallelWriters) {
+  constexpr std::size_t slice = 1000;
+  constexpr std::size_t workers = 4;
+  cds_vector<std::size_t> v(slice * workers, std::size_t{0});
+  {
+    auto session = v.new_range_session();
+    std::vector<std::thread> threads;
+    for (std::size_t w = 0; w < workers; ++w) {
+      threads.emplace_back([&, w] {
+        auto range = session.lock_range(w * slice, (w + 1) * slice);
+        for (std::size_t i = 0; i < range.size(); ++i) {
+          range[i] = range.first() + i;
+        }
+      });
+    }
+    // This straddles every slice, so it waits for all of them.
+    threads.emplace_back([&] {
+      auto range = session.lock_range(slice / 2, slice * workers - slice / 2);
+      for (auto& value : range) {
+        value += 1;
+      }
+    });
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  // The straddling writer ran either before or after each slice writer, but
+  // never during it, so its increment survives uniformly per slice.
+  auto read = v.new_scoped_read();
+  for (std::size_t w = 0; w < workers; ++w) {
+    const std::size_t first = std::max(w * slice, slice / 2);
+    const std::size_t last =
+        std::min((w + 1) * slice, slice * workers - slice / 2);
+    const std::size_t delta = read[first] - first;
+    EXPECT_LE(delta, 1);
+    for (std::size_t i = w * slice; i < (w + 1) * slice; ++i) {
+      EXPECT_EQ(read[i], i + (i >= first && i < last ? delta : 0));
+    }
+  }
+}